@@ -27,6 +27,7 @@
 #include <util.h>
 
 #include <ctype.h>
+#include <time.h>
 #include <libyasm/compat-queue.h>
 #include <libyasm/bitvect.h>
 #include <libyasm.h>
@@ -46,9 +47,13 @@
 /* Preprocess-only buffer size */
 #define PREPROC_BUF_SIZE    16384
 
+/* Object file output stdio buffer size */
+#define OBJ_OUTPUT_BUFSIZE  (256*1024)
+
 /*@null@*/ /*@only@*/ static char *obj_filename = NULL, *in_filename = NULL;
 /*@null@*/ /*@only@*/ static char *global_prefix = NULL, *global_suffix = NULL;
 /*@null@*/ /*@only@*/ static char *list_filename = NULL, *map_filename = NULL;
+/*@null@*/ /*@only@*/ static char *size_report_filename = NULL;
 /*@null@*/ /*@only@*/ static char *machine_name = NULL;
 static int special_options = 0;
 /*@null@*/ /*@dependent@*/ static yasm_arch *cur_arch = NULL;
@@ -71,6 +76,19 @@ static int preproc_only = 0;
 static unsigned int force_strict = 0;
 static int generate_make_dependencies = 0;
 static int warning_error = 0;   /* warnings being treated as errors */
+static int show_stats = 0;      /* print assembly statistics when done */
+static int show_source = 0;     /* print source line with errors/warnings */
+/* line mapping used to look up source lines for error/warning messages */
+static /*@null@*/ /*@dependent@*/ yasm_linemap *errwarn_linemap = NULL;
+static unsigned long align_branches = 0;    /* branch padding boundary */
+static unsigned long align_loops = 0;       /* loop head alignment */
+static unsigned long align_loops_max_skip = 0;
+static unsigned long optimize_encoding = 0; /* shortest-encoding level */
+static enum {
+    INSN_STATS_NONE = 0,
+    INSN_STATS_TABLE,
+    INSN_STATS_JSON
+} insn_stats = INSN_STATS_NONE;
 static FILE *errfile;
 /*@null@*/ /*@only@*/ static char *error_filename = NULL;
 static enum {
@@ -80,6 +98,9 @@ static enum {
 
 /*@null@*/ /*@dependent@*/ static FILE *open_file(const char *filename,
                                                   const char *mode);
+static void stats_phase_done(const char *phase);
+static void print_stats(yasm_object *object);
+static void write_size_report(FILE *f, yasm_object *object);
 static void check_errors(/*@only@*/ yasm_errwarns *errwarns,
                          /*@only@*/ yasm_object *object,
                          /*@only@*/ yasm_linemap *linemap);
@@ -96,6 +117,8 @@ static int opt_listfmt_handler(char *cmd, /*@null@*/ char *param, int extra);
 static int opt_listfile_handler(char *cmd, /*@null@*/ char *param, int extra);
 static int opt_objfile_handler(char *cmd, /*@null@*/ char *param, int extra);
 static int opt_mapfile_handler(char *cmd, /*@null@*/ char *param, int extra);
+static int opt_size_report_handler(char *cmd, /*@null@*/ char *param,
+                                   int extra);
 static int opt_machine_handler(char *cmd, /*@null@*/ char *param, int extra);
 static int opt_strict_handler(char *cmd, /*@null@*/ char *param, int extra);
 static int opt_warning_handler(char *cmd, /*@null@*/ char *param, int extra);
@@ -108,6 +131,17 @@ static int opt_ewmsg_handler(char *cmd, /*@null@*/ char *param, int extra);
 static int opt_makedep_handler(char *cmd, /*@null@*/ char *param, int extra);
 static int opt_prefix_handler(char *cmd, /*@null@*/ char *param, int extra);
 static int opt_suffix_handler(char *cmd, /*@null@*/ char *param, int extra);
+static int opt_stats_handler(char *cmd, /*@null@*/ char *param, int extra);
+static int opt_show_source_handler(char *cmd, /*@null@*/ char *param,
+                                   int extra);
+static int opt_align_branches_handler(char *cmd, /*@null@*/ char *param,
+                                      int extra);
+static int opt_align_loops_handler(char *cmd, /*@null@*/ char *param,
+                                   int extra);
+static int opt_optimize_encoding_handler(char *cmd, /*@null@*/ char *param,
+                                         int extra);
+static int opt_insn_stats_handler(char *cmd, /*@null@*/ char *param,
+                                  int extra);
 #if defined(CMAKE_BUILD) && defined(BUILD_SHARED_LIBS)
 static int opt_plugin_handler(char *cmd, /*@null@*/ char *param, int extra);
 #endif
@@ -170,6 +204,8 @@ static opt_option options[] =
       N_("name of object-file output"), N_("filename") },
     { 0, "mapfile", 1, opt_mapfile_handler, 0,
       N_("name of map-file output"), N_("filename") },
+    { 0, "size-report", 1, opt_size_report_handler, 0,
+      N_("write per-function code sizes to a file"), N_("filename") },
     { 'm', "machine", 1, opt_machine_handler, 0,
       N_("select machine (list with -m help)"), N_("machine") },
     { 0, "force-strict", 0, opt_strict_handler, 0,
@@ -210,6 +246,21 @@ static opt_option options[] =
       N_("append argument to name of all external symbols"), N_("suffix") },
     { 0, "postfix", 1, opt_suffix_handler, 0,
       N_("append argument to name of all external symbols"), N_("suffix") },
+    { 0, "stats", 0, opt_stats_handler, 0,
+      N_("print per-phase assembly statistics to the error stream"), NULL },
+    { 0, "show-source", 0, opt_show_source_handler, 0,
+      N_("show the source line of each error and warning"), NULL },
+    { 0, "align-branches-within", 1, opt_align_branches_handler, 0,
+      N_("pad so no branch crosses or ends on a boundary (x86 only)"),
+      N_("boundary") },
+    { 0, "align-loops", 1, opt_align_loops_handler, 0,
+      N_("align backward branch targets, skipping at most maxskip bytes (x86 only)"),
+      N_("boundary[:maxskip]") },
+    { 0, "optimize-encoding", 0, opt_optimize_encoding_handler, 0,
+      N_("use shorter equivalent instruction encodings (x86 only)"), NULL },
+    { 0, "insn-stats", 1, opt_insn_stats_handler, 0,
+      N_("print instruction encoding statistics (`table' or `json')"),
+      N_("format") },
 #if defined(CMAKE_BUILD) && defined(BUILD_SHARED_LIBS)
     { 'N', "plugin", 1, opt_plugin_handler, 0,
       N_("load plugin module"), N_("plugin") },
@@ -248,6 +299,15 @@ typedef struct constcharparam {
 
 static constcharparam_head preproc_options;
 
+/* per-phase timing storage for --stats */
+#define MAX_STATS_PHASES    8
+static struct {
+    const char *name;
+    clock_t ticks;
+} stats_phases[MAX_STATS_PHASES];
+static size_t num_stats_phases = 0;
+static clock_t stats_phase_start;
+
 static int
 do_preproc_only(void)
 {
@@ -260,6 +320,7 @@ do_preproc_only(void)
 
     /* Initialize line map */
     linemap = yasm_linemap_create();
+    errwarn_linemap = linemap;
     yasm_linemap_set(linemap, in_filename, 0, 1, 1);
 
     /* Default output to stdout if not specified or generating dependency
@@ -357,6 +418,7 @@ do_assemble(void)
     yasm_object *object;
     const char *base_filename;
     /*@null@*/ FILE *obj = NULL;
+    /*@null@*/ /*@only@*/ char *obj_buf = NULL;
     yasm_arch_create_error arch_error;
     yasm_linemap *linemap;
     yasm_errwarns *errwarns = yasm_errwarns_create();
@@ -365,6 +427,7 @@ do_assemble(void)
 
     /* Initialize line map */
     linemap = yasm_linemap_create();
+    errwarn_linemap = linemap;
     yasm_linemap_set(linemap, in_filename, 0, 1, 1);
 
     /* determine the object filename if not specified */
@@ -491,6 +554,33 @@ do_assemble(void)
 
     yasm_arch_set_var(cur_arch, "force_strict", force_strict);
 
+    if (align_branches != 0 &&
+        yasm_arch_set_var(cur_arch, "align_branches", align_branches) != 0)
+        print_error(
+            _("warning: architecture `%s' does not support branch alignment"),
+            cur_arch_module->keyword);
+
+    if (align_loops != 0 &&
+        (yasm_arch_set_var(cur_arch, "align_loops", align_loops) != 0 ||
+         yasm_arch_set_var(cur_arch, "align_loops_max_skip",
+                           align_loops_max_skip) != 0))
+        print_error(
+            _("warning: architecture `%s' does not support loop alignment"),
+            cur_arch_module->keyword);
+
+    if (optimize_encoding != 0 &&
+        yasm_arch_set_var(cur_arch, "optimize_encoding",
+                          optimize_encoding) != 0)
+        print_error(
+            _("warning: architecture `%s' does not support encoding optimization"),
+            cur_arch_module->keyword);
+
+    if (insn_stats != INSN_STATS_NONE &&
+        yasm_arch_set_var(cur_arch, "insn_stats", 1) != 0)
+        print_error(
+            _("warning: architecture `%s' does not support instruction statistics"),
+            cur_arch_module->keyword);
+
     /* Try to enable the map file via a map NASM directive.  This is
      * somewhat of a hack.
      */
@@ -518,21 +608,26 @@ do_assemble(void)
     }
 
     /* Parse! */
+    stats_phase_start = clock();
     cur_parser_module->do_parse(object, cur_preproc, list_filename != NULL,
                                 linemap, errwarns);
+    stats_phase_done(N_("preprocess+parse"));
 
     check_errors(errwarns, object, linemap);
 
     /* Finalize parse */
     yasm_object_finalize(object, errwarns);
+    stats_phase_done(N_("finalize"));
     check_errors(errwarns, object, linemap);
 
     /* Optimize */
     yasm_object_optimize(object, errwarns);
+    stats_phase_done(N_("optimize"));
     check_errors(errwarns, object, linemap);
 
     /* generate any debugging information */
     yasm_dbgfmt_generate(object, linemap, errwarns);
+    stats_phase_done(N_("debug info"));
     check_errors(errwarns, object, linemap);
 
     /* open the object file for output (if not already opened by dbg objfmt) */
@@ -542,9 +637,19 @@ do_assemble(void)
             cleanup(object);
             return EXIT_FAILURE;
         }
+
+        /* Object formats write mostly small per-bytecode chunks, so give
+         * stdio a large buffer to cut down on the number of write calls.
+         */
+        obj_buf = yasm_xmalloc(OBJ_OUTPUT_BUFSIZE);
+        if (setvbuf(obj, obj_buf, _IOFBF, OBJ_OUTPUT_BUFSIZE) != 0) {
+            yasm_xfree(obj_buf);
+            obj_buf = NULL;
+        }
     }
 
     /* Write the object file */
+    stats_phase_start = clock();
     yasm_objfmt_output(object, obj?obj:stderr,
                        yasm__strcasecmp(cur_dbgfmt_module->keyword, "null"),
                        errwarns);
@@ -552,6 +657,9 @@ do_assemble(void)
     /* Close object file */
     if (obj)
         fclose(obj);
+    if (obj_buf)
+        yasm_xfree(obj_buf);
+    stats_phase_done(N_("output"));
 
     /* If we had an error at this point, we also need to delete the output
      * object file (to make sure it's not left newer than the source).
@@ -574,9 +682,29 @@ do_assemble(void)
         fclose(list);
     }
 
+    /* Open and write the size report */
+    if (size_report_filename) {
+        FILE *report = stdout;
+        if (strcmp(size_report_filename, "-") != 0 &&
+            !(report = open_file(size_report_filename, "wt"))) {
+            cleanup(object);
+            return EXIT_FAILURE;
+        }
+        write_size_report(report, object);
+        if (report != stdout)
+            fclose(report);
+    }
+
     yasm_errwarns_output_all(errwarns, linemap, warning_error,
                              print_yasm_error, print_yasm_warning);
 
+    if (insn_stats != INSN_STATS_NONE)
+        yasm_arch_print_insn_stats(cur_arch, object, stdout,
+                                   insn_stats == INSN_STATS_JSON);
+
+    if (show_stats)
+        print_stats(object);
+
     yasm_linemap_destroy(linemap);
     yasm_errwarns_destroy(errwarns);
     cleanup(object);
@@ -780,6 +908,214 @@ check_errors(yasm_errwarns *errwarns, yasm_object *object,
     }
 }
 
+/* Record the time taken since stats_phase_start as the named phase, and
+ * start timing the next phase.
+ */
+static void
+stats_phase_done(const char *phase)
+{
+    clock_t now = clock();
+
+    if (num_stats_phases < MAX_STATS_PHASES) {
+        stats_phases[num_stats_phases].name = phase;
+        stats_phases[num_stats_phases].ticks = now - stats_phase_start;
+        num_stats_phases++;
+    }
+    stats_phase_start = now;
+}
+
+typedef struct align_stats {
+    unsigned long branches;     /* number of branches padded */
+    unsigned long branch_bytes; /* total branch padding bytes */
+    unsigned long loops;        /* number of loop heads aligned */
+    unsigned long loops_skipped;    /* loop heads over the maximum skip */
+    unsigned long loop_bytes;   /* total loop alignment bytes */
+} align_stats;
+
+static int
+count_align(yasm_bytecode *bc, /*@null@*/ void *d)
+{
+    align_stats *stats = (align_stats *)d;
+    int aligned;
+
+    if (yasm_bc_is_branch_pad(bc) && bc->len > 0) {
+        stats->branches++;
+        stats->branch_bytes += bc->len;
+    } else if (yasm_bc_get_loop_align(bc, &aligned)) {
+        if (aligned)
+            stats->loops++;
+        else
+            stats->loops_skipped++;
+        stats->loop_bytes += bc->len;
+    }
+    return 0;
+}
+
+static int
+count_section_align(yasm_section *sect, /*@null@*/ void *d)
+{
+    return yasm_section_bcs_traverse(sect, NULL, d, count_align);
+}
+
+static void
+print_stats(yasm_object *object)
+{
+    size_t i;
+    clock_t total = 0;
+
+    fprintf(errfile, "%s:\n", _("assembly statistics"));
+    for (i=0; i<num_stats_phases; i++) {
+        fprintf(errfile, "  %-20s %10.3f s\n", _(stats_phases[i].name),
+                (double)stats_phases[i].ticks/CLOCKS_PER_SEC);
+        total += stats_phases[i].ticks;
+    }
+    fprintf(errfile, "  %-20s %10.3f s\n", _("total"),
+            (double)total/CLOCKS_PER_SEC);
+    if (cur_preproc)
+        yasm_preproc_print_stats(cur_preproc, errfile);
+
+    if (align_branches != 0 || align_loops != 0) {
+        align_stats stats = {0, 0, 0, 0, 0};
+        yasm_object_sections_traverse(object, &stats, count_section_align);
+        if (align_branches != 0)
+            fprintf(errfile, "  %-20s %10lu (%lu %s)\n", _("branch padding"),
+                    stats.branch_bytes, stats.branches, _("branches"));
+        if (align_loops != 0)
+            fprintf(errfile, "  %-20s %10lu (%lu %s, %lu %s)\n",
+                    _("loop alignment"), stats.loop_bytes, stats.loops,
+                    _("loops aligned"), stats.loops_skipped,
+                    _("over maximum skip"));
+    }
+
+    if (optimize_encoding != 0) {
+        unsigned long saved;
+        if (yasm_arch_get_var(cur_arch, "encoding_saved", &saved) == 0)
+            fprintf(errfile, "  %-20s %10lu\n", _("encoding bytes saved"),
+                    saved);
+    }
+}
+
+typedef struct size_report {
+    FILE *f;
+    int list_funcs;             /* print a line per function */
+    /*@null@*/ /*@dependent@*/ const char *func; /* current function */
+    unsigned long func_bytes;   /* bytes in current function */
+    unsigned long func_padding; /* fill bytes in current function */
+    unsigned long padding;      /* fill bytes in section */
+} size_report;
+
+/* Does a label start a new function?  Labels starting with a dot (such as
+ * GAS .L labels) and NASM local labels of the current function do not.
+ */
+static int
+size_report_is_func(const char *name, /*@null@*/ const char *func)
+{
+    size_t len;
+
+    if (name[0] == '.')
+        return 0;
+    if (!func)
+        return 1;
+    len = strlen(func);
+    return strncmp(name, func, len) != 0 || name[len] != '.';
+}
+
+static void
+size_report_end_func(size_report *report)
+{
+    if (report->list_funcs && report->func_bytes > 0)
+        fprintf(report->f, "  %-30s %10lu %10lu\n",
+                report->func ? report->func : _("(no label)"),
+                report->func_bytes, report->func_padding);
+    report->func_bytes = 0;
+    report->func_padding = 0;
+}
+
+/* Labels attached to a bytecode follow it. */
+static void
+size_report_labels(yasm_bytecode *bc, size_report *report)
+{
+    yasm_symrec **sym;
+
+    if (!bc->symrecs)
+        return;
+    for (sym = bc->symrecs; *sym; sym++) {
+        const char *name = yasm_symrec_get_name(*sym);
+        if (size_report_is_func(name, report->func)) {
+            size_report_end_func(report);
+            report->func = name;
+        }
+    }
+}
+
+static int
+size_report_bc(yasm_bytecode *bc, /*@null@*/ void *d)
+{
+    size_report *report = (size_report *)d;
+    unsigned long len = yasm_bc_next_offset(bc) - bc->offset;
+
+    report->func_bytes += len;
+    if (yasm_bc_is_padding(bc)) {
+        report->func_padding += len;
+        report->padding += len;
+    }
+    size_report_labels(bc, report);
+    return 0;
+}
+
+static int
+size_report_section(yasm_section *sect, /*@null@*/ void *d)
+{
+    size_report *report = (size_report *)d;
+    yasm_reloc *reloc;
+    unsigned long relocs = 0;
+
+    /* First pass for the section totals */
+    report->list_funcs = 0;
+    report->padding = 0;
+    yasm_section_bcs_traverse(sect, NULL, report, size_report_bc);
+
+    for (reloc = yasm_section_relocs_first(sect); reloc;
+         reloc = yasm_section_reloc_next(reloc))
+        relocs++;
+
+    fprintf(report->f, "%-32s %10lu %10lu %10lu\n",
+            yasm_section_get_name(sect),
+            yasm_bc_next_offset(yasm_section_bcs_last(sect)),
+            report->padding, relocs);
+
+    /* Second pass to list the functions in code sections */
+    if (yasm_section_is_code(sect)) {
+        report->list_funcs = 1;
+        report->func = NULL;
+        report->func_bytes = 0;
+        report->func_padding = 0;
+        size_report_labels(yasm_section_bcs_first(sect), report);
+        yasm_section_bcs_traverse(sect, NULL, report, size_report_bc);
+        size_report_end_func(report);
+    }
+    return 0;
+}
+
+/* Report section and function sizes, using the bytecode lengths left by
+ * the optimizer.  A function runs from a label to the next label that is
+ * not local to it.
+ */
+static void
+write_size_report(FILE *f, yasm_object *object)
+{
+    size_report report;
+
+    report.f = f;
+    report.func = NULL;
+    report.func_bytes = 0;
+    report.func_padding = 0;
+
+    fprintf(f, "%-32s %10s %10s %10s\n", _("section/function"), _("bytes"),
+            _("padding"), _("relocs"));
+    yasm_object_sections_traverse(object, &report, size_report_section);
+}
+
 /* Define DO_FREE to 1 to enable deallocation of all data structures.
  * Useful for detecting memory leaks, but slows down execution unnecessarily
  * (as the OS will free everything we miss here).
@@ -815,6 +1151,8 @@ cleanup(yasm_object *object)
             yasm_xfree(list_filename);
         if (map_filename)
             yasm_xfree(map_filename);
+        if (size_report_filename)
+            yasm_xfree(size_report_filename);
         if (machine_name)
             yasm_xfree(machine_name);
         if (objfmt_keyword)
@@ -1039,6 +1377,22 @@ opt_mapfile_handler(/*@unused@*/ char *cmd, char *param,
     return 0;
 }
 
+static int
+opt_size_report_handler(/*@unused@*/ char *cmd, char *param,
+                        /*@unused@*/ int extra)
+{
+    if (size_report_filename) {
+        print_error(
+            _("warning: can output to only one size report, last specified used"));
+        yasm_xfree(size_report_filename);
+    }
+
+    assert(param != NULL);
+    size_report_filename = yasm__xstrdup(param);
+
+    return 0;
+}
+
 static int
 opt_machine_handler(/*@unused@*/ char *cmd, char *param,
                     /*@unused@*/ int extra)
@@ -1206,6 +1560,87 @@ opt_suffix_handler(/*@unused@*/ char *cmd, char *param, /*@unused@*/ int extra)
     return 0;
 }
 
+static int
+opt_stats_handler(/*@unused@*/ char *cmd, /*@unused@*/ char *param,
+                  /*@unused@*/ int extra)
+{
+    show_stats = 1;
+    return 0;
+}
+
+static int
+opt_show_source_handler(/*@unused@*/ char *cmd, /*@unused@*/ char *param,
+                        /*@unused@*/ int extra)
+{
+    show_source = 1;
+    return 0;
+}
+
+static int
+opt_align_branches_handler(/*@unused@*/ char *cmd, char *param,
+                           /*@unused@*/ int extra)
+{
+    char *end;
+    unsigned long val;
+
+    assert(param != NULL);
+    val = strtoul(param, &end, 10);
+    if (*end != '\0' || (val != 0 &&
+        (val < 16 || val > 4096 || (val & (val-1)) != 0))) {
+        print_error(_("branch alignment boundary must be 0 or a power of two from 16 to 4096"));
+        return 1;
+    }
+    align_branches = val;
+    return 0;
+}
+
+static int
+opt_align_loops_handler(/*@unused@*/ char *cmd, char *param,
+                        /*@unused@*/ int extra)
+{
+    char *end;
+    unsigned long val, maxskip;
+
+    assert(param != NULL);
+    val = strtoul(param, &end, 10);
+    maxskip = val > 0 ? val-1 : 0;
+    if (*end == ':')
+        maxskip = strtoul(end+1, &end, 10);
+    if (*end != '\0' || val > 4096 || (val & (val-1)) != 0) {
+        print_error(_("loop alignment boundary must be 0 or a power of two up to 4096"));
+        return 1;
+    }
+    align_loops = val;
+    align_loops_max_skip = (val > 0 && maxskip >= val) ? val-1 : maxskip;
+    return 0;
+}
+
+static int
+opt_insn_stats_handler(/*@unused@*/ char *cmd, char *param,
+                       /*@unused@*/ int extra)
+{
+    assert(param != NULL);
+    if (yasm__strcasecmp(param, "table") == 0)
+        insn_stats = INSN_STATS_TABLE;
+    else if (yasm__strcasecmp(param, "json") == 0)
+        insn_stats = INSN_STATS_JSON;
+    else {
+        print_error(_("unrecognized instruction statistics format `%s'"),
+                    param);
+        return 1;
+    }
+    return 0;
+}
+
+static int
+opt_optimize_encoding_handler(/*@unused@*/ char *cmd,
+                              /*@unused@*/ char *param,
+                              /*@unused@*/ int extra)
+{
+    optimize_encoding = 1;
+    return 0;
+}
+
 #if defined(CMAKE_BUILD) && defined(BUILD_SHARED_LIBS)
 static int
 opt_plugin_handler(/*@unused@*/ char *cmd, char *param,
@@ -1391,6 +1826,29 @@ static const char *fmt_noline[2] = {
         "%s : %s%s\n"   /* VC */
 };
 
+static void
+print_source_line(const char *filename, unsigned long line)
+{
+    static const char *last_filename = NULL;
+    static unsigned long last_line = 0;
+    char buf[1024];
+
+    if (!show_source || !errwarn_linemap || !line)
+        return;
+
+    /* Only show the line once for consecutive messages about it */
+    if (line == last_line && last_filename &&
+        strcmp(filename, last_filename) == 0)
+        return;
+    last_filename = filename;
+    last_line = line;
+
+    if (yasm_linemap_read_physical_source(errwarn_linemap, filename, line,
+                                          buf, sizeof(buf)) != 0)
+        return;
+    fprintf(errfile, "    %s\n", buf);
+}
+
 static void
 print_yasm_error(const char *filename, unsigned long line, const char *msg,
                  const char *xref_fn, unsigned long xref_line,
@@ -1400,6 +1858,7 @@ print_yasm_error(const char *filename, unsigned long line, const char *msg,
         fprintf(errfile, fmt[ewmsg_style], filename, line, _("error: "), msg);
     else
         fprintf(errfile, fmt_noline[ewmsg_style], filename, _("error: "), msg);
+    print_source_line(filename, line);
 
     if (xref_fn && xref_msg) {
         if (xref_line)
@@ -1420,4 +1879,5 @@ print_yasm_warning(const char *filename, unsigned long line, const char *msg)
     else
         fprintf(errfile, fmt_noline[ewmsg_style], filename, _("warning: "),
                 msg);
+    print_source_line(filename, line);
 }
@@ -126,6 +126,18 @@ typedef struct yasm_arch_module {
      */
     int (*set_var) (yasm_arch *arch, const char *var, unsigned long val);
 
+    /** Module-level implementation of yasm_arch_get_var().
+     * Call yasm_arch_get_var() instead of calling this function.
+     */
+    int (*get_var) (const yasm_arch *arch, const char *var,
+                    /*@out@*/ unsigned long *val);
+
+    /** Module-level implementation of yasm_arch_print_insn_stats().
+     * Call yasm_arch_print_insn_stats() instead of calling this function.
+     */
+    void (*print_insn_stats) (yasm_arch *arch, yasm_object *object, FILE *f,
+                              int json);
+
     /** Module-level implementation of yasm_arch_parse_check_insnprefix().
      * Call yasm_arch_parse_check_insnprefix() instead of calling this function.
      */
@@ -289,6 +301,27 @@ unsigned int yasm_arch_get_address_size(const yasm_arch *arch);
  */
 int yasm_arch_set_var(yasm_arch *arch, const char *var, unsigned long val);
 
+/** Get any arch-specific variables, including statistics kept by the
+ * architecture while assembling.
+ * \param arch  architecture
+ * \param var   variable name
+ * \param val   value (output)
+ * \return Zero on success, non-zero on failure (variable does not exist).
+ */
+int yasm_arch_get_var(const yasm_arch *arch, const char *var,
+                      /*@out@*/ unsigned long *val);
+
+/** Print instruction encoding statistics for an optimized object.  Only
+ * prints anything if statistics were enabled (for example, with the
+ * "insn_stats" variable in x86) before parsing.
+ * \param arch      architecture
+ * \param object    object
+ * \param f         file
+ * \param json      nonzero to print as a JSON object, zero for a table
+ */
+void yasm_arch_print_insn_stats(yasm_arch *arch, yasm_object *object,
+                                FILE *f, int json);
+
 /** Check an generic identifier to see if it matches architecture specific
  * names for instructions or instruction prefixes.  Unrecognized identifiers
  * should return #YASM_ARCH_NOTINSNPREFIX so they can be treated as normal
@@ -457,6 +490,10 @@ void yasm_arch_ea_print(const yasm_arch *arch, const yasm_effaddr *ea,
     ((yasm_arch_base *)arch)->module->get_address_size(arch)
 #define yasm_arch_set_var(arch, var, val) \
     ((yasm_arch_base *)arch)->module->set_var(arch, var, val)
+#define yasm_arch_get_var(arch, var, val) \
+    ((yasm_arch_base *)arch)->module->get_var(arch, var, val)
+#define yasm_arch_print_insn_stats(arch, object, f, json) \
+    ((yasm_arch_base *)arch)->module->print_insn_stats(arch, object, f, json)
 #define yasm_arch_parse_check_insnprefix(arch, id, id_len, line, bc, prefix) \
     ((yasm_arch_base *)arch)->module->parse_check_insnprefix \
         (arch, id, id_len, line, bc, prefix)
@@ -49,6 +49,27 @@ typedef struct bytecode_align {
     /*@null@*/ const unsigned char **code_fill;
 } bytecode_align;
 
+typedef struct bytecode_loop_align {
+    /* Last branch (in section order) targeting the loop head */
+    /*@dependent@*/ yasm_bytecode *branch;
+
+    unsigned long boundary;     /* alignment boundary */
+    unsigned long maxskip;      /* maximum number of bytes to skip */
+
+    /* Code fill, NULL if using 0 fill */
+    /*@null@*/ const unsigned char **code_fill;
+} bytecode_loop_align;
+
+typedef struct bytecode_branch_pad {
+    unsigned long boundary;     /* boundary not to cross (power of two) */
+
+    /* Number of following bytecodes to keep within the boundary */
+    unsigned int num_bcs;
+
+    /* Code fill, NULL if using 0 fill */
+    /*@null@*/ const unsigned char **code_fill;
+} bytecode_branch_pad;
+
 static void bc_align_destroy(void *contents);
 static void bc_align_print(const void *contents, FILE *f, int indent_level);
 static void bc_align_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc);
@@ -62,6 +83,34 @@ static int bc_align_tobytes(yasm_bytecode *bc, unsigned char **bufp,
                             yasm_output_value_func output_value,
                             /*@null@*/ yasm_output_reloc_func output_reloc);
 
+static void bc_branch_pad_destroy(void *contents);
+static void bc_branch_pad_print(const void *contents, FILE *f,
+                                int indent_level);
+static int bc_branch_pad_calc_len(yasm_bytecode *bc,
+                                  yasm_bc_add_span_func add_span,
+                                  void *add_span_data);
+static int bc_branch_pad_expand(yasm_bytecode *bc, int span, long old_val,
+                                long new_val, /*@out@*/ long *neg_thres,
+                                /*@out@*/ long *pos_thres);
+static int bc_branch_pad_tobytes(yasm_bytecode *bc, unsigned char **bufp,
+                                 unsigned char *bufstart, void *d,
+                                 yasm_output_value_func output_value,
+                                 /*@null@*/ yasm_output_reloc_func output_reloc);
+
+static void bc_loop_align_destroy(void *contents);
+static void bc_loop_align_print(const void *contents, FILE *f,
+                                int indent_level);
+static int bc_loop_align_calc_len(yasm_bytecode *bc,
+                                  yasm_bc_add_span_func add_span,
+                                  void *add_span_data);
+static int bc_loop_align_expand(yasm_bytecode *bc, int span, long old_val,
+                                long new_val, /*@out@*/ long *neg_thres,
+                                /*@out@*/ long *pos_thres);
+static int bc_loop_align_tobytes(yasm_bytecode *bc, unsigned char **bufp,
+                                 unsigned char *bufstart, void *d,
+                                 yasm_output_value_func output_value,
+                                 /*@null@*/ yasm_output_reloc_func output_reloc);
+
 static const yasm_bytecode_callback bc_align_callback = {
     bc_align_destroy,
     bc_align_print,
@@ -73,6 +122,28 @@ static const yasm_bytecode_callback bc_align_callback = {
     YASM_BC_SPECIAL_OFFSET
 };
 
+static const yasm_bytecode_callback bc_loop_align_callback = {
+    bc_loop_align_destroy,
+    bc_loop_align_print,
+    yasm_bc_finalize_common,
+    NULL,
+    bc_loop_align_calc_len,
+    bc_loop_align_expand,
+    bc_loop_align_tobytes,
+    YASM_BC_SPECIAL_OFFSET
+};
+
+static const yasm_bytecode_callback bc_branch_pad_callback = {
+    bc_branch_pad_destroy,
+    bc_branch_pad_print,
+    yasm_bc_finalize_common,
+    NULL,
+    bc_branch_pad_calc_len,
+    bc_branch_pad_expand,
+    bc_branch_pad_tobytes,
+    YASM_BC_SPECIAL_OFFSET
+};
+
 
 static void
 bc_align_destroy(void *contents)
@@ -163,6 +234,44 @@ bc_align_expand(yasm_bytecode *bc, int span, long old_val, long new_val,
     return 1;
 }
 
+/* Output len bytes of code fill (or 0 fill if code_fill is NULL). */
+static int
+align_code_fill(unsigned char **bufp, unsigned long len,
+                /*@null@*/ const unsigned char **code_fill)
+{
+    if (code_fill) {
+        unsigned long maxlen = 15;
+        while (!code_fill[maxlen] && maxlen>0)
+            maxlen--;
+        if (maxlen == 0) {
+            yasm_error_set(YASM_ERROR_GENERAL,
+                           N_("could not find any code alignment size"));
+            return 1;
+        }
+
+        /* Fill with maximum code fill as much as possible */
+        while (len > maxlen) {
+            memcpy(*bufp, code_fill[maxlen], maxlen);
+            *bufp += maxlen;
+            len -= maxlen;
+        }
+
+        if (!code_fill[len]) {
+            yasm_error_set(YASM_ERROR_VALUE,
+                           N_("invalid alignment size %d"), len);
+            return 1;
+        }
+        /* Handle rest of code fill */
+        memcpy(*bufp, code_fill[len], len);
+        *bufp += len;
+    } else {
+        /* Just fill with 0 */
+        memset(*bufp, 0, len);
+        *bufp += len;
+    }
+    return 0;
+}
+
 static int
 bc_align_tobytes(yasm_bytecode *bc, unsigned char **bufp,
                  unsigned char *bufstart, void *d,
@@ -196,36 +305,8 @@ bc_align_tobytes(yasm_bytecode *bc, unsigned char **bufp,
         v = yasm_intnum_get_uint(yasm_expr_get_intnum(&align->fill, 0));
         memset(*bufp, (int)v, len);
         *bufp += len;
-    } else if (align->code_fill) {
-        unsigned long maxlen = 15;
-        while (!align->code_fill[maxlen] && maxlen>0)
-            maxlen--;
-        if (maxlen == 0) {
-            yasm_error_set(YASM_ERROR_GENERAL,
-                           N_("could not find any code alignment size"));
-            return 1;
-        }
-
-        /* Fill with maximum code fill as much as possible */
-        while (len > maxlen) {
-            memcpy(*bufp, align->code_fill[maxlen], maxlen);
-            *bufp += maxlen;
-            len -= maxlen;
-        }
-
-        if (!align->code_fill[len]) {
-            yasm_error_set(YASM_ERROR_VALUE,
-                           N_("invalid alignment size %d"), len);
-            return 1;
-        }
-        /* Handle rest of code fill */
-        memcpy(*bufp, align->code_fill[len], len);
-        *bufp += len;
-    } else {
-        /* Just fill with 0 */
-        memset(*bufp, 0, len);
-        *bufp += len;
-    }
+    } else
+        return align_code_fill(bufp, len, align->code_fill);
     return 0;
 }
 
@@ -243,3 +324,206 @@ yasm_bc_create_align(yasm_expr *boundary, yasm_expr *fill,
 
     return yasm_bc_create_common(&bc_align_callback, align, line);
 }
+
+static void
+bc_branch_pad_destroy(void *contents)
+{
+    yasm_xfree(contents);
+}
+
+static void
+bc_branch_pad_print(const void *contents, FILE *f, int indent_level)
+{
+    const bytecode_branch_pad *pad = (const bytecode_branch_pad *)contents;
+    fprintf(f, "%*s_Branch_Pad_\n", indent_level, "");
+    fprintf(f, "%*sBoundary=%lu\n", indent_level, "", pad->boundary);
+    fprintf(f, "%*sNum Bytecodes=%u\n", indent_level, "", pad->num_bcs);
+}
+
+static int
+bc_branch_pad_calc_len(yasm_bytecode *bc, yasm_bc_add_span_func add_span,
+                       void *add_span_data)
+{
+    long neg_thres = 0;
+    long pos_thres = 0;
+
+    if (bc_branch_pad_expand(bc, 0, 0, (long)bc->offset, &neg_thres,
+                             &pos_thres) < 0)
+        return -1;
+
+    return 0;
+}
+
+/* The padding depends both on our own offset and on the current length of
+ * the bytecodes we keep together, so the optimizer re-runs this whenever
+ * either changes.
+ */
+static int
+bc_branch_pad_expand(yasm_bytecode *bc, int span, long old_val, long new_val,
+                     /*@out@*/ long *neg_thres, /*@out@*/ long *pos_thres)
+{
+    bytecode_branch_pad *pad = (bytecode_branch_pad *)bc->contents;
+    yasm_bytecode *next = bc;
+    unsigned long len = 0;
+    unsigned int i;
+
+    for (i=0; i<pad->num_bcs; i++) {
+        next = yasm_bc__next(next);
+        if (!next)
+            break;
+        len += next->len*next->mult_int;
+    }
+
+    *pos_thres = new_val;
+
+    /* Pad to the next boundary if the bytecodes would cross or end on it.
+     * If they can't fit within a boundary at all, don't bother.
+     */
+    if (len > 0 && len < pad->boundary &&
+        ((unsigned long)new_val & (pad->boundary-1)) + len >= pad->boundary)
+        bc->len = pad->boundary -
+            ((unsigned long)new_val & (pad->boundary-1));
+    else
+        bc->len = 0;
+    return 1;
+}
+
+static int
+bc_branch_pad_tobytes(yasm_bytecode *bc, unsigned char **bufp,
+                      unsigned char *bufstart, void *d,
+                      yasm_output_value_func output_value,
+                      /*@unused@*/ yasm_output_reloc_func output_reloc)
+{
+    bytecode_branch_pad *pad = (bytecode_branch_pad *)bc->contents;
+
+    if (bc->len == 0)
+        return 0;
+    return align_code_fill(bufp, bc->len, pad->code_fill);
+}
+
+yasm_bytecode *
+yasm_bc_create_branch_pad(unsigned long boundary, unsigned int num_bcs,
+                          const unsigned char **code_fill, unsigned long line)
+{
+    bytecode_branch_pad *pad = yasm_xmalloc(sizeof(bytecode_branch_pad));
+
+    pad->boundary = boundary;
+    pad->num_bcs = num_bcs;
+    pad->code_fill = code_fill;
+
+    return yasm_bc_create_common(&bc_branch_pad_callback, pad, line);
+}
+
+int
+yasm_bc_is_branch_pad(const yasm_bytecode *bc)
+{
+    return bc->callback == &bc_branch_pad_callback;
+}
+
+static void
+bc_loop_align_destroy(void *contents)
+{
+    yasm_xfree(contents);
+}
+
+static void
+bc_loop_align_print(const void *contents, FILE *f, int indent_level)
+{
+    const bytecode_loop_align *loop = (const bytecode_loop_align *)contents;
+    fprintf(f, "%*s_Loop_Align_\n", indent_level, "");
+    fprintf(f, "%*sBoundary=%lu\n", indent_level, "", loop->boundary);
+    fprintf(f, "%*sMax Skip=%lu\n", indent_level, "", loop->maxskip);
+}
+
+static int
+bc_loop_align_calc_len(yasm_bytecode *bc, yasm_bc_add_span_func add_span,
+                       void *add_span_data)
+{
+    /* Whether the branch is backward isn't known until all bytecodes have
+     * been indexed, so start out empty; the first offset update (optimizer
+     * step 1c) sizes us.
+     */
+    bc->len = 0;
+    return 0;
+}
+
+/* Only loop heads targeted by a later branch are aligned; they are known
+ * from the bytecode indexes assigned by the optimizer.
+ */
+static int
+bc_loop_align_expand(yasm_bytecode *bc, int span, long old_val, long new_val,
+                     /*@out@*/ long *neg_thres, /*@out@*/ long *pos_thres)
+{
+    bytecode_loop_align *loop = (bytecode_loop_align *)bc->contents;
+    unsigned long len;
+
+    *pos_thres = new_val;
+    bc->len = 0;
+
+    if (loop->branch->bc_index <= bc->bc_index)
+        return 1;
+
+    len = (0UL - (unsigned long)new_val) & (loop->boundary-1);
+    if (len <= loop->maxskip)
+        bc->len = len;
+    return 1;
+}
+
+static int
+bc_loop_align_tobytes(yasm_bytecode *bc, unsigned char **bufp,
+                      unsigned char *bufstart, void *d,
+                      yasm_output_value_func output_value,
+                      /*@unused@*/ yasm_output_reloc_func output_reloc)
+{
+    bytecode_loop_align *loop = (bytecode_loop_align *)bc->contents;
+
+    if (bc->len == 0)
+        return 0;
+    return align_code_fill(bufp, bc->len, loop->code_fill);
+}
+
+yasm_bytecode *
+yasm_bc_create_loop_align(yasm_bytecode *branch, unsigned long boundary,
+                          unsigned long maxskip,
+                          const unsigned char **code_fill, unsigned long line)
+{
+    bytecode_loop_align *loop = yasm_xmalloc(sizeof(bytecode_loop_align));
+
+    loop->branch = branch;
+    loop->boundary = boundary;
+    loop->maxskip = maxskip;
+    loop->code_fill = code_fill;
+
+    return yasm_bc_create_common(&bc_loop_align_callback, loop, line);
+}
+
+int
+yasm_bc_loop_align_add_branch(yasm_bytecode *bc, yasm_bytecode *branch)
+{
+    if (bc->callback != &bc_loop_align_callback)
+        return 1;
+    ((bytecode_loop_align *)bc->contents)->branch = branch;
+    return 0;
+}
+
+int
+yasm_bc_get_loop_align(const yasm_bytecode *bc, int *aligned)
+{
+    const bytecode_loop_align *loop;
+
+    if (bc->callback != &bc_loop_align_callback)
+        return 0;
+    loop = (const bytecode_loop_align *)bc->contents;
+    if (loop->branch->bc_index <= bc->bc_index)
+        return 0;
+    *aligned = ((bc->offset + bc->len) & (loop->boundary-1)) == 0;
+    return 1;
+}
+
+int
+yasm_bc_is_padding(const yasm_bytecode *bc)
+{
+    return bc->callback == &bc_align_callback
+        || bc->callback == &bc_branch_pad_callback
+        || bc->callback == &bc_loop_align_callback;
+}
@@ -376,6 +376,73 @@ YASM_LIB_DECL
      /*@keep@*/ /*@null@*/ yasm_expr *maxskip,
      /*@null@*/ const unsigned char **code_fill, unsigned long line);
 
+/** Create a bytecode that pads the following bytecode(s) so they neither
+ * cross nor end on a boundary.  Used to keep branches (or macro-fused
+ * compare and branch pairs) within a single instruction fetch block.
+ * \param boundary      byte boundary (must be a power of two)
+ * \param num_bcs       number of following bytecodes to keep together
+ * \param code_fill     code fill data (if NULL, 0 is used)
+ * \param line          virtual line (from yasm_linemap)
+ * \return Newly allocated bytecode.
+ */
+YASM_LIB_DECL
+/*@only@*/ yasm_bytecode *yasm_bc_create_branch_pad
+    (unsigned long boundary, unsigned int num_bcs,
+     /*@null@*/ const unsigned char **code_fill, unsigned long line);
+
+/** Determine if a bytecode is a branch padding bytecode.
+ * \param bc            bytecode
+ * \return Nonzero if bc was created by yasm_bc_create_branch_pad().
+ */
+YASM_LIB_DECL
+int yasm_bc_is_branch_pad(const yasm_bytecode *bc);
+
+/** Create a bytecode that aligns a loop head, i.e. the following bytecode
+ * when it is the target of a later (backward) branch.  No alignment is done
+ * if the branch is forward or the alignment would need more than maxskip
+ * bytes.
+ * \param branch        branch bytecode targeting the loop head
+ * \param boundary      byte alignment (must be a power of two)
+ * \param maxskip       maximum number of bytes to skip
+ * \param code_fill     code fill data (if NULL, 0 is used)
+ * \param line          virtual line (from yasm_linemap)
+ * \return Newly allocated bytecode.
+ */
+YASM_LIB_DECL
+/*@only@*/ yasm_bytecode *yasm_bc_create_loop_align
+    (/*@dependent@*/ yasm_bytecode *branch, unsigned long boundary,
+     unsigned long maxskip, /*@null@*/ const unsigned char **code_fill,
+     unsigned long line);
+
+/** Add another branch targeting the loop head aligned by a loop alignment
+ * bytecode.  Branches must be added in section order.
+ * \param bc            bytecode
+ * \param branch        branch bytecode targeting the loop head
+ * \return Nonzero if bc is not a loop alignment bytecode.
+ */
+YASM_LIB_DECL
+int yasm_bc_loop_align_add_branch(yasm_bytecode *bc,
+                                  /*@dependent@*/ yasm_bytecode *branch);
+
+/** Get the outcome of a loop alignment bytecode after optimization.
+ * \param bc            bytecode
+ * \param aligned       set nonzero if the loop head was aligned, zero if
+ *                      alignment was skipped due to the maximum skip
+ *                      (returned)
+ * \return Nonzero if bc is a loop alignment bytecode for a loop head that is
+ *         the target of a backward branch.
+ */
+YASM_LIB_DECL
+int yasm_bc_get_loop_align(const yasm_bytecode *bc, /*@out@*/ int *aligned);
+
+/** Determine if a bytecode is alignment fill: an align, branch padding, or
+ * loop alignment bytecode.
+ * \param bc            bytecode
+ * \return Nonzero if bc only generates fill bytes.
+ */
+YASM_LIB_DECL
+int yasm_bc_is_padding(const yasm_bytecode *bc);
+
 /** Create a bytecode that puts the following bytecode at a fixed section
  * offset.
  * \param start         section offset of following bytecode
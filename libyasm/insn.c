@@ -26,6 +26,8 @@
  */
 #include "util.h"
 
+#include <ctype.h>
+
 #include "libyasm-stdint.h"
 #include "coretype.h"
 
@@ -63,6 +65,10 @@ yasm_operand_create_reg(uintptr_t reg)
     retval->size = 0;
     retval->deref = 0;
     retval->strict = 0;
+    retval->zeroing = 0;
+    retval->bcst = 0;
+    retval->rounding = YASM_INSN_ROUND_NONE;
+    retval->opmask = 0;
 
     return retval;
 }
@@ -79,6 +85,10 @@ yasm_operand_create_segreg(uintptr_t segreg)
     retval->size = 0;
     retval->deref = 0;
     retval->strict = 0;
+    retval->zeroing = 0;
+    retval->bcst = 0;
+    retval->rounding = YASM_INSN_ROUND_NONE;
+    retval->opmask = 0;
 
     return retval;
 }
@@ -95,6 +105,10 @@ yasm_operand_create_mem(/*@only@*/ yasm_effaddr *ea)
     retval->size = 0;
     retval->deref = 0;
     retval->strict = 0;
+    retval->zeroing = 0;
+    retval->bcst = 0;
+    retval->rounding = YASM_INSN_ROUND_NONE;
+    retval->opmask = 0;
     retval->size = ea->data_len * 8;
 
     return retval;
@@ -119,11 +133,85 @@ yasm_operand_create_imm(/*@only@*/ yasm_expr *val)
         retval->size = 0;
         retval->deref = 0;
         retval->strict = 0;
+        retval->zeroing = 0;
+        retval->bcst = 0;
+        retval->rounding = YASM_INSN_ROUND_NONE;
+        retval->opmask = 0;
     }
 
     return retval;
 }
 
+int
+yasm_operand_add_decorator(yasm_insn_operand *op, yasm_arch *arch,
+                           const char *deco)
+{
+    static const struct {
+        const char *name;
+        yasm_insn_rounding rounding;
+    } roundings[] = {
+        {"sae",     YASM_INSN_ROUND_SAE},
+        {"rn-sae",  YASM_INSN_ROUND_RN_SAE},
+        {"rd-sae",  YASM_INSN_ROUND_RD_SAE},
+        {"ru-sae",  YASM_INSN_ROUND_RU_SAE},
+        {"rz-sae",  YASM_INSN_ROUND_RZ_SAE}
+    };
+    uintptr_t reg;
+    size_t i;
+
+    if (yasm__strcasecmp(deco, "z") == 0) {
+        op->zeroing = 1;
+        return 0;
+    }
+
+    if (yasm__strncasecmp(deco, "1to", 3) == 0) {
+        unsigned long n = strtoul(deco+3, NULL, 10);
+        const char *s;
+
+        for (s = deco+3; isdigit((unsigned char)*s); s++)
+            ;
+        if (s == deco+3 || *s != '\0' || n < 2 || n > 64 || (n & (n-1))) {
+            yasm_error_set(YASM_ERROR_SYNTAX,
+                           N_("invalid broadcast decorator `{%s}'"), deco);
+            return 1;
+        }
+        if (op->bcst) {
+            yasm_error_set(YASM_ERROR_SYNTAX,
+                           N_("duplicate broadcast decorator"));
+            return 1;
+        }
+        op->bcst = (unsigned int)n;
+        return 0;
+    }
+
+    for (i=0; i<NELEMS(roundings); i++) {
+        if (yasm__strcasecmp(deco, roundings[i].name) == 0) {
+            if (op->rounding != YASM_INSN_ROUND_NONE) {
+                yasm_error_set(YASM_ERROR_SYNTAX,
+                               N_("duplicate rounding decorator"));
+                return 1;
+            }
+            op->rounding = roundings[i].rounding;
+            return 0;
+        }
+    }
+
+    if (yasm_arch_parse_check_regtmod(arch, deco, strlen(deco), &reg)
+        == YASM_ARCH_REG) {
+        if (op->opmask) {
+            yasm_error_set(YASM_ERROR_SYNTAX,
+                           N_("duplicate write mask decorator"));
+            return 1;
+        }
+        op->opmask = reg;
+        return 0;
+    }
+
+    yasm_error_set(YASM_ERROR_SYNTAX, N_("unrecognized decorator `{%s}'"),
+                   deco);
+    return 1;
+}
+
 yasm_insn_operand *
 yasm_insn_ops_append(yasm_insn *insn, yasm_insn_operand *op)
 {
@@ -229,6 +317,11 @@ yasm_insn_print(const yasm_insn *insn, FILE *f, int indent_level)
         fprintf(f, "%*sSize=%u\n", indent_level+1, "", op->size);
         fprintf(f, "%*sDeref=%d, Strict=%d\n", indent_level+1, "",
                 (int)op->deref, (int)op->strict);
+        if (op->opmask || op->zeroing || op->bcst || op->rounding)
+            fprintf(f, "%*sMask=%lx, Zeroing=%d, Bcst=%u, Rounding=%d\n",
+                    indent_level+1, "", (unsigned long)op->opmask,
+                    (int)op->zeroing, (unsigned int)op->bcst,
+                    (int)op->rounding);
     }
 }
 
@@ -87,6 +87,16 @@ typedef enum yasm_insn_operand_type {
     YASM_INSN__OPERAND_IMM          /**< An immediate or jump target. */
 } yasm_insn_operand_type;
 
+/** Embedded rounding control requested by an operand decorator. */
+typedef enum yasm_insn_rounding {
+    YASM_INSN_ROUND_NONE = 0,       /**< No rounding decorator. */
+    YASM_INSN_ROUND_SAE,            /**< {sae}: suppress all exceptions. */
+    YASM_INSN_ROUND_RN_SAE,         /**< {rn-sae}: round to nearest. */
+    YASM_INSN_ROUND_RD_SAE,         /**< {rd-sae}: round down. */
+    YASM_INSN_ROUND_RU_SAE,         /**< {ru-sae}: round up. */
+    YASM_INSN_ROUND_RZ_SAE          /**< {rz-sae}: round toward zero. */
+} yasm_insn_rounding;
+
 /** An instruction operand. */
 struct yasm_insn_operand {
     /** Link for building linked list of operands.  \internal */
@@ -129,6 +139,18 @@ struct yasm_insn_operand {
 
     /** Operand type. */
     unsigned int type:4;
+
+    /** Nonzero if zeroing-masking was requested ("{z}"). */
+    unsigned int zeroing:1;
+
+    /** Broadcast element count ("{1to16}" etc), 0 if not broadcast. */
+    unsigned int bcst:7;
+
+    /** Embedded rounding control (see #yasm_insn_rounding). */
+    unsigned int rounding:3;
+
+    /** Arch register used as a write mask ("{k1}"), 0 if none. */
+    uintptr_t opmask;
 };
 
 /** Base structure for "instruction" bytecodes.  These are the mnenomic
@@ -190,6 +212,20 @@ yasm_insn_operand *yasm_operand_create_mem(/*@only@*/ yasm_effaddr *ea);
 YASM_LIB_DECL
 yasm_insn_operand *yasm_operand_create_imm(/*@only@*/ yasm_expr *val);
 
+/** Apply an operand decorator (the contents of a "{...}" following an
+ * operand, without the braces) to an instruction operand.  Recognized
+ * decorators are a write mask register, "z", "1toN", and the rounding
+ * controls "sae", "rn-sae", "rd-sae", "ru-sae", and "rz-sae".
+ * \param op            operand
+ * \param arch          architecture (used to look up mask registers)
+ * \param deco          decorator text
+ * \return 0 on success; nonzero (and an error is set) if the decorator is
+ *         not recognized or conflicts with one already applied.
+ */
+YASM_LIB_DECL
+int yasm_operand_add_decorator(yasm_insn_operand *op, yasm_arch *arch,
+                               const char *deco);
+
 /** Get the first operand in an instruction.
  * \param insn          instruction
  * \return First operand (NULL if no operands).
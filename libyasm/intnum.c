@@ -795,6 +795,24 @@ yasm_intnum_get_sized(const yasm_intnum *intn, unsigned char *ptr,
         yasm_warn_set(YASM_WARN_GENERAL,
                       N_("value does not fit in %d bit field"), valsize);
 
+    /* Fast path: a small value filling whole destination bytes can be
+     * written out directly (sign extended) without going through the
+     * bitvector read-modify-write below.
+     */
+    if (intn->type == INTNUM_L && shift == 0 && !bigendian
+        && valsize == destsize*8) {
+        unsigned long ul = (unsigned long)intn->val.l;
+        size_t i;
+
+        for (i=0; i<destsize; i++) {
+            if (i < 4)
+                ptr[i] = (unsigned char)((ul >> (i*8)) & 0xFF);
+            else
+                ptr[i] = intn->val.l < 0 ? 0xFF : 0;
+        }
+        return;
+    }
+
     /* Read the original data into a bitvect */
     if (bigendian) {
         /* TODO */
@@ -842,6 +860,23 @@ yasm_intnum_check_size(const yasm_intnum *intn, size_t size, size_t rshift,
 {
     wordptr val;
 
+    /* Values held in a long can be checked against fields narrower than
+     * a long without a bitvector conversion.
+     */
+    if (intn->type == INTNUM_L && rshift == 0 && size > 0 &&
+        size < sizeof(long)*8) {
+        long v = intn->val.l;
+
+        if (v < 0) {
+            if (rangetype <= 0)
+                return 0;
+            return v >= -(1L << (size-1));
+        }
+        if (rangetype == 1)
+            size--;
+        return (unsigned long)v < (1UL << size);
+    }
+
     /* If not already a bitvect, convert value to a bitvect */
     if (intn->type == INTNUM_BV) {
         if (rshift > 0) {
@@ -882,10 +917,18 @@ yasm_intnum_check_size(const yasm_intnum *intn, size_t size, size_t rshift,
 int
 yasm_intnum_in_range(const yasm_intnum *intn, long low, long high)
 {
-    wordptr val = intnum_tobv(result, intn);
+    wordptr val;
     wordptr lval = op1static;
     wordptr hval = op2static;
 
+    /* Values that fit in a long (the common case for displacements and
+     * immediates checked during optimization) can be compared directly.
+     */
+    if (intn->type == INTNUM_L)
+        return (intn->val.l >= low && intn->val.l <= high);
+
+    val = intnum_tobv(result, intn);
+
     /* Convert high and low to bitvects */
     BitVector_Empty(lval);
     if (low >= 0)
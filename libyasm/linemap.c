@@ -54,6 +54,20 @@ typedef struct line_source_info {
     /*@owned@*/ char *source;
 } line_source_info;
 
+typedef struct source_file_index {
+    /* physical filename (shared storage) */
+    /*@dependent@*/ const char *filename;
+
+    /* open file; NULL if the file could not be read */
+    /*@null@*/ FILE *f;
+
+    /* file offset of the start of each line */
+    /*@only@*/ /*@null@*/ long *offsets;
+    unsigned long num_lines;
+
+    /*@null@*/ struct source_file_index *next;
+} source_file_index;
+
 struct yasm_linemap {
     /* Shared storage for filenames */
     /*@only@*/ /*@null@*/ HAMT *filenames;
@@ -69,6 +83,9 @@ struct yasm_linemap {
     /* Bytecode and source line information */
     /*@only@*/ line_source_info *source_info;
     size_t source_info_size;
+
+    /* Line offset indexes of physical files, built on first request */
+    /*@only@*/ /*@null@*/ source_file_index *source_files;
 };
 
 static void
@@ -77,14 +94,31 @@ filename_delete_one(/*@only@*/ void *d)
     yasm_xfree(d);
 }
 
-void
-yasm_linemap_set(yasm_linemap *linemap, const char *filename,
-                 unsigned long virtual_line, unsigned long file_line,
-                 unsigned long line_inc)
+const char *
+yasm_linemap_intern_filename(yasm_linemap *linemap, const char *filename)
 {
+    const char *shared;
     char *copy;
-    unsigned long i;
     int replace = 0;
+
+    shared = HAMT_search(linemap->filenames, filename);
+    if (shared)
+        return shared;
+
+    /* Copy the filename into shared storage */
+    copy = yasm__xstrdup(filename);
+    /*@-aliasunique@*/
+    return HAMT_insert(linemap->filenames, copy, copy, &replace,
+                       filename_delete_one);
+    /*@=aliasunique@*/
+}
+
+void
+yasm_linemap_set_interned(yasm_linemap *linemap, const char *filename,
+                          unsigned long virtual_line, unsigned long file_line,
+                          unsigned long line_inc)
+{
+    unsigned long i;
     line_mapping *mapping = NULL;
 
     if (virtual_line == 0) {
@@ -118,25 +152,27 @@ yasm_linemap_set(yasm_linemap *linemap, const char *filename,
 
     if (!filename) {
         if (linemap->map_size >= 2)
-            mapping->filename =
-                linemap->map_vector[linemap->map_size-2].filename;
+            filename = linemap->map_vector[linemap->map_size-2].filename;
         else
-            filename = "unknown";
-    }
-    if (filename) {
-        /* Copy the filename (via shared storage) */
-        copy = yasm__xstrdup(filename);
-        /*@-aliasunique@*/
-        mapping->filename = HAMT_insert(linemap->filenames, copy, copy,
-                                        &replace, filename_delete_one);
-        /*@=aliasunique@*/
+            filename = yasm_linemap_intern_filename(linemap, "unknown");
     }
 
+    mapping->filename = filename;
     mapping->line = virtual_line;
     mapping->file_line = file_line;
     mapping->line_inc = line_inc;
 }
 
+void
+yasm_linemap_set(yasm_linemap *linemap, const char *filename,
+                 unsigned long virtual_line, unsigned long file_line,
+                 unsigned long line_inc)
+{
+    yasm_linemap_set_interned(linemap,
+        filename ? yasm_linemap_intern_filename(linemap, filename) : NULL,
+        virtual_line, file_line, line_inc);
+}
+
 unsigned long
 yasm_linemap_poke(yasm_linemap *linemap, const char *filename,
                   unsigned long file_line)
@@ -152,7 +188,7 @@ yasm_linemap_poke(yasm_linemap *linemap, const char *filename,
     line = linemap->current;
 
     linemap->current++;
-    yasm_linemap_set(linemap, mapping->filename, 0,
+    yasm_linemap_set_interned(linemap, mapping->filename, 0,
                      mapping->file_line +
                      mapping->line_inc*(linemap->current-2-mapping->line),
                      mapping->line_inc);
@@ -184,6 +220,8 @@ yasm_linemap_create(void)
         linemap->source_info[i].source = NULL;
     }
 
+    linemap->source_files = NULL;
+
     return linemap;
 }
 
@@ -191,12 +229,23 @@ void
 yasm_linemap_destroy(yasm_linemap *linemap)
 {
     size_t i;
+    source_file_index *sfi, *sfi_next;
+
     for (i=0; i<linemap->source_info_size; i++) {
         if (linemap->source_info[i].source)
             yasm_xfree(linemap->source_info[i].source);
     }
     yasm_xfree(linemap->source_info);
 
+    for (sfi = linemap->source_files; sfi; sfi = sfi_next) {
+        sfi_next = sfi->next;
+        if (sfi->f)
+            fclose(sfi->f);
+        if (sfi->offsets)
+            yasm_xfree(sfi->offsets);
+        yasm_xfree(sfi);
+    }
+
     yasm_xfree(linemap->map_vector);
 
     if (linemap->filenames)
@@ -205,6 +254,81 @@ yasm_linemap_destroy(yasm_linemap *linemap)
     yasm_xfree(linemap);
 }
 
+static /*@dependent@*/ source_file_index *
+source_file_index_get(yasm_linemap *linemap, const char *filename)
+{
+    source_file_index *sfi;
+    unsigned long allocated;
+    long offset = 0;
+    int ch;
+
+    filename = yasm_linemap_intern_filename(linemap, filename);
+    for (sfi = linemap->source_files; sfi; sfi = sfi->next) {
+        if (sfi->filename == filename)
+            return sfi;
+    }
+
+    sfi = yasm_xmalloc(sizeof(source_file_index));
+    sfi->filename = filename;
+    sfi->offsets = NULL;
+    sfi->num_lines = 0;
+    sfi->next = linemap->source_files;
+    linemap->source_files = sfi;
+
+    /* Standard input can't be read a second time */
+    if (strcmp(filename, "-") == 0) {
+        sfi->f = NULL;
+        return sfi;
+    }
+    sfi->f = fopen(filename, "rb");
+    if (!sfi->f)
+        return sfi;
+
+    /* Record where each line starts in a single pass over the file */
+    allocated = 64;
+    sfi->offsets = yasm_xmalloc(allocated*sizeof(long));
+    sfi->offsets[sfi->num_lines++] = 0;
+    while ((ch = getc(sfi->f)) != EOF) {
+        offset++;
+        if (ch != '\n')
+            continue;
+        if (sfi->num_lines >= allocated) {
+            allocated *= 2;
+            sfi->offsets = yasm_xrealloc(sfi->offsets,
+                                         allocated*sizeof(long));
+        }
+        sfi->offsets[sfi->num_lines++] = offset;
+    }
+    return sfi;
+}
+
+int
+yasm_linemap_read_physical_source(yasm_linemap *linemap,
+                                  const char *filename,
+                                  unsigned long file_line, char *buf,
+                                  size_t max_size)
+{
+    source_file_index *sfi;
+    size_t len;
+
+    if (!filename || file_line == 0 || max_size == 0)
+        return 1;
+
+    sfi = source_file_index_get(linemap, filename);
+    if (!sfi->f || file_line > sfi->num_lines)
+        return 1;
+
+    if (fseek(sfi->f, sfi->offsets[file_line-1], SEEK_SET) != 0 ||
+        !fgets(buf, (int)max_size, sfi->f))
+        return 1;
+
+    /* Strip the line ending */
+    len = strlen(buf);
+    while (len > 0 && (buf[len-1] == '\n' || buf[len-1] == '\r'))
+        buf[--len] = '\0';
+    return 0;
+}
+
 unsigned long
 yasm_linemap_get_current(yasm_linemap *linemap)
 {
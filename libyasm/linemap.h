@@ -101,6 +101,33 @@ void yasm_linemap_set(yasm_linemap *linemap, /*@null@*/ const char *filename,
                       unsigned long virtual_line, unsigned long file_line,
                       unsigned long line_inc);
 
+/** Get the shared copy of a physical file name kept by a line map, adding
+ * it if not already present.  The returned pointer remains valid for the
+ * lifetime of the line map.
+ * \param linemap       line mapping repository
+ * \param filename      physical file name
+ * \return Shared copy of filename.
+ */
+YASM_LIB_DECL
+/*@dependent@*/ const char *yasm_linemap_intern_filename
+    (yasm_linemap *linemap, const char *filename);
+
+/** Same as yasm_linemap_set(), but without looking up or copying the file
+ * name.  Useful for callers that change the association often.
+ * \param linemap       line mapping repository
+ * \param filename      physical file name returned by
+ *                      yasm_linemap_intern_filename() (if NULL, not changed)
+ * \param virtual_line  virtual line number (if 0, linemap->current is used)
+ * \param file_line     physical line number
+ * \param line_inc      line increment
+ */
+YASM_LIB_DECL
+void yasm_linemap_set_interned(yasm_linemap *linemap,
+                               /*@null@*/ /*@dependent@*/ const char *filename,
+                               unsigned long virtual_line,
+                               unsigned long file_line,
+                               unsigned long line_inc);
+
 /** Poke a single file/line association, restoring the original physical
  * association starting point.  Caution: increments the current virtual line
  * twice.
@@ -114,6 +141,24 @@ unsigned long yasm_linemap_poke(yasm_linemap *linemap,
                                 /*@null@*/ const char *filename,
                                 unsigned long file_line);
 
+/** Read the text of a physical source line back from its file.  Lines are
+ * not retained in memory; instead each file is indexed by line the first
+ * time it is requested, and later requests seek directly to the line.
+ * \param linemap       line mapping repository
+ * \param filename      physical file name
+ * \param file_line     physical line number
+ * \param buf           buffer for the line text (output); the line ending
+ *                      is removed, and longer lines are truncated
+ * \param max_size      size of buf in bytes
+ * \return Nonzero if the line could not be read (e.g. the file was standard
+ *         input or no longer exists).
+ */
+YASM_LIB_DECL
+int yasm_linemap_read_physical_source(yasm_linemap *linemap,
+                                      const char *filename,
+                                      unsigned long file_line, char *buf,
+                                      size_t max_size);
+
 /** Look up the associated physical file and line for a virtual line.
  * \param linemap       line mapping repository
  * \param line          virtual line
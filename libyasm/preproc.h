@@ -106,6 +106,17 @@ typedef struct yasm_preproc_module {
      * Call yasm_preproc_add_standard() instead of calling this function.
      */
     void (*add_standard) (yasm_preproc *preproc, const char **macros);
+
+    /** Module-level implementation of yasm_preproc_print_stats().
+     * Call yasm_preproc_print_stats() instead of calling this function.
+     */
+    void (*print_stats) (yasm_preproc *preproc, FILE *f);
+
+    /** Module-level implementation of yasm_preproc_set_direct_linemap().
+     * Call yasm_preproc_set_direct_linemap() instead of calling this
+     * function.
+     */
+    void (*set_direct_linemap) (yasm_preproc *preproc, int direct);
 } yasm_preproc_module;
 
 /** Initialize preprocessor.
@@ -178,6 +189,25 @@ void yasm_preproc_define_builtin(yasm_preproc *preproc,
 void yasm_preproc_add_standard(yasm_preproc *preproc,
                                const char **macros);
 
+/** Print preprocessor statistics (if any) for the input processed so far.
+ * \param preproc       preprocessor
+ * \param f             file to print to
+ */
+void yasm_preproc_print_stats(yasm_preproc *preproc, FILE *f);
+
+/** Select how source position changes (e.g. at %include or macro
+ * boundaries) are reported.  By default, preprocessors that track them
+ * insert line directives such as `%line' into the returned source.  In
+ * direct mode, they instead set the line mapping repository given at
+ * creation before returning the first line at the new position.  Only use
+ * direct mode if each line returned by yasm_preproc_get_line() is fully
+ * processed, including yasm_linemap_goto_next(), before the next is
+ * requested.
+ * \param preproc       preprocessor
+ * \param direct        nonzero to set the line map directly
+ */
+void yasm_preproc_set_direct_linemap(yasm_preproc *preproc, int direct);
+
 #ifndef YASM_DOXYGEN
 
 /* Inline macro implementations for preproc functions */
@@ -204,6 +234,11 @@ void yasm_preproc_add_standard(yasm_preproc *preproc,
 #define yasm_preproc_add_standard(preproc, macros) \
     ((yasm_preproc_base *)preproc)->module->add_standard(preproc, \
                                                          macros)
+#define yasm_preproc_print_stats(preproc, f) \
+    ((yasm_preproc_base *)preproc)->module->print_stats(preproc, f)
+#define yasm_preproc_set_direct_linemap(preproc, direct) \
+    ((yasm_preproc_base *)preproc)->module->set_direct_linemap(preproc, \
+                                                               direct)
 
 #endif
 
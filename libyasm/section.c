@@ -70,6 +70,14 @@ struct yasm_section {
     int def;                    /* "default" section, e.g. not specified by
                                    using section directive */
 
+    /* Output layout relative to the previous section in the object, as
+     * provided by the object format.  If layout_follows is nonzero, this
+     * section starts directly after the previous one, aligned to
+     * layout_align (or the section alignment, if larger).
+     */
+    int layout_follows;
+    unsigned long layout_align;
+
     /* the bytecodes for the section's contents */
     /*@reldef@*/ STAILQ_HEAD(yasm_bytecodehead, yasm_bytecode) bcs;
 
@@ -348,6 +356,8 @@ yasm_object_get_general(yasm_object *object, const char *name,
     s->code = code;
     s->res_only = res_only;
     s->def = 0;
+    s->layout_follows = 0;
+    s->layout_align = 0;
 
     /* Initialize object format specific data */
     yasm_objfmt_init_new_section(s, line);
@@ -430,6 +440,39 @@ yasm_section_set_default(yasm_section *sect, int def)
     sect->def = def;
 }
 
+void
+yasm_section_set_layout_follows(yasm_section *sect, int follows,
+                                unsigned long align)
+{
+    sect->layout_follows = follows;
+    sect->layout_align = align;
+}
+
+int
+yasm_section_is_layout_linked(const yasm_section *sect,
+                              const yasm_section *other)
+{
+    const yasm_section *s;
+
+    if (sect == other)
+        return 1;
+
+    /* Walk forward from each section in turn; every section passed through
+     * must directly follow its predecessor.
+     */
+    for (s = STAILQ_NEXT(sect, link); s && s->layout_follows;
+         s = STAILQ_NEXT(s, link)) {
+        if (s == other)
+            return 1;
+    }
+    for (s = STAILQ_NEXT(other, link); s && s->layout_follows;
+         s = STAILQ_NEXT(s, link)) {
+        if (s == sect)
+            return 1;
+    }
+    return 0;
+}
+
 yasm_object *
 yasm_section_get_object(const yasm_section *sect)
 {
@@ -621,6 +664,41 @@ yasm_section_bcs_append(yasm_section *sect, yasm_bytecode *bc)
     return (yasm_bytecode *)NULL;
 }
 
+yasm_bytecode *
+yasm_section_bcs_insert_after(yasm_section *sect, yasm_bytecode *prevbc,
+                              yasm_bytecode *bc)
+{
+    if (bc) {
+        if (bc->callback) {
+            bc->section = sect;     /* record parent section */
+            STAILQ_INSERT_AFTER(&sect->bcs, prevbc, bc, link);
+            return bc;
+        } else
+            yasm_xfree(bc);
+    }
+    return (yasm_bytecode *)NULL;
+}
+
+void
+yasm_section_align_loop_head(yasm_section *sect, yasm_bytecode *precbc,
+                             yasm_bytecode *branch, unsigned long boundary,
+                             unsigned long maxskip,
+                             const unsigned char **code_fill)
+{
+    yasm_bytecode *bc;
+
+    /* Already aligning this location for another branch?  If so, the
+     * labels have been moved to follow the alignment bytecode.
+     */
+    if (yasm_bc_loop_align_add_branch(precbc, branch) == 0)
+        return;
+
+    bc = yasm_bc_create_loop_align(branch, boundary, maxskip, code_fill,
+                                   branch->line);
+    yasm_section_bcs_insert_after(sect, precbc, bc);
+    yasm_symrec__move_labels(precbc, bc);
+}
+
 int
 yasm_section_bcs_traverse(yasm_section *sect,
                           /*@null@*/ yasm_errwarns *errwarns,
@@ -815,7 +893,9 @@ yasm_section_print(const yasm_section *sect, FILE *f, int indent_level,
  *     Update span:
  *       If BC no longer dependent on span, mark span as inactive.
  *       If BC has new thresholds for span, update span.
- *     If BC increased in size, for each active span that contains BC:
+ *     If BC increased in size, re-expand the offset-setter preceding BC
+ *     (its length may depend on BC's length, e.g. branch padding), then
+ *     for each active span that contains BC:
  *       Increase span length by difference between short and long BC length.
  *       If span exceeds long threshold (or is flagged to recalculate on any
  *       change), add it to tail of Q.
@@ -874,6 +954,12 @@ struct yasm_span {
 
     /* First offset setter following this span's bytecode */
     yasm_offset_setter *os;
+
+    /* Last offset setter preceding this span's bytecode in the same
+     * section, NULL if none.  Its length may depend on the length of this
+     * span's bytecode (e.g. branch padding).
+     */
+    /*@null@*/ yasm_offset_setter *prev_os;
 };
 
 typedef struct optimize_data {
@@ -885,11 +971,13 @@ typedef struct optimize_data {
     long len_diff;      /* used only for optimize_term_expand */
     yasm_span *span;    /* used only for check_cycle */
     yasm_offset_setter *os;
+    /*@null@*/ yasm_offset_setter *prev_os;
 } optimize_data;
 
 static yasm_span *
 create_span(yasm_bytecode *bc, int id, /*@null@*/ const yasm_value *value, 
-            long neg_thres, long pos_thres, yasm_offset_setter *os)
+            long neg_thres, long pos_thres, yasm_offset_setter *os,
+            /*@null@*/ yasm_offset_setter *prev_os)
 {
     yasm_span *span = yasm_xmalloc(sizeof(yasm_span));
 
@@ -911,6 +999,7 @@ create_span(yasm_bytecode *bc, int id, /*@null@*/ const yasm_value *value,
     span->backtrace = NULL;
     span->backtrace_size = 0;
     span->os = os;
+    span->prev_os = prev_os;
 
     return span;
 }
@@ -921,7 +1010,8 @@ optimize_add_span(void *add_span_data, yasm_bytecode *bc, int id,
 {
     optimize_data *optd = (optimize_data *)add_span_data;
     yasm_span *span;
-    span = create_span(bc, id, value, neg_thres, pos_thres, optd->os);
+    span = create_span(bc, id, value, neg_thres, pos_thres, optd->os,
+                       optd->prev_os);
     TAILQ_INSERT_TAIL(&optd->spans, span, link);
 }
 
@@ -951,6 +1041,59 @@ add_span_term(unsigned int subst, yasm_bytecode *precbc,
     yasm_intnum_destroy(intn);
 }
 
+/* Get the maximum padding inserted before a section that follows the
+ * previous section in the output.
+ */
+static unsigned long
+section_layout_gap(const yasm_section *sect)
+{
+    unsigned long align = sect->layout_align;
+
+    if (sect->align > align)
+        align = sect->align;
+    return align > 0 ? align-1 : 0;
+}
+
+/* Calculate the distance from the start of a span's bytecode to the end of
+ * the relative term's target bytecode.  The target may be in another section
+ * linked by output layout, in which case padding between sections is
+ * counted at its maximum, giving the distance of largest magnitude.
+ */
+static long
+span_rel_dist(const yasm_span *span)
+{
+    yasm_bytecode *precbc2 = span->rel_term->precbc2;
+    const yasm_section *lo, *hi, *sect;
+    unsigned long lo_off, hi_off, dist;
+
+    if (precbc2->section == span->bc->section)
+        return (long)(yasm_bc_next_offset(precbc2) - span->bc->offset);
+
+    if (precbc2->bc_index > span->bc->bc_index) {
+        lo = span->bc->section;
+        lo_off = span->bc->offset;
+        hi = precbc2->section;
+        hi_off = yasm_bc_next_offset(precbc2);
+    } else {
+        lo = precbc2->section;
+        lo_off = yasm_bc_next_offset(precbc2);
+        hi = span->bc->section;
+        hi_off = span->bc->offset;
+    }
+
+    dist = yasm_bc_next_offset(STAILQ_LAST(&lo->bcs, yasm_bytecode, link)) -
+        lo_off;
+    for (sect = STAILQ_NEXT(lo, link); sect != hi;
+         sect = STAILQ_NEXT(sect, link))
+        dist += section_layout_gap(sect) +
+            yasm_bc_next_offset(STAILQ_LAST(&sect->bcs, yasm_bytecode, link));
+    dist += section_layout_gap(hi) + hi_off;
+
+    if (lo == span->bc->section)
+        return (long)dist;
+    return -(long)dist;
+}
+
 static void
 span_create_terms(yasm_span *span)
 {
@@ -988,8 +1131,14 @@ span_create_terms(yasm_span *span)
         if (span->depval.wrt || span->depval.seg_of || span->depval.section_rel
             || !sym_local)
             return;     /* we can't handle SEG, WRT, or external symbols */
-        if (rel_precbc->section != span->bc->section)
-            return;     /* not in this section */
+        /* Distances to other sections include worst-case padding between
+         * sections, so they're only good enough for threshold checks.
+         */
+        if (rel_precbc->section != span->bc->section
+            && (span->id <= 0
+                || !yasm_section_is_layout_linked(span->bc->section,
+                                                  rel_precbc->section)))
+            return;     /* not in this section or a linked section */
         if (!span->depval.curpos_rel)
             return;     /* not PC-relative */
 
@@ -1000,8 +1149,7 @@ span_create_terms(yasm_span *span)
         span->rel_term->subst = ~0U;
 
         span->rel_term->cur_val = 0;
-        span->rel_term->new_val = yasm_bc_next_offset(rel_precbc) -
-            span->bc->offset;
+        span->rel_term->new_val = span_rel_dist(span);
     }
 }
 
@@ -1317,6 +1465,7 @@ yasm_object_optimize(yasm_object *object, yasm_errwarns *errwarns)
         yasm_bytecode *bc = STAILQ_FIRST(&sect->bcs);
 
         bc->bc_index = bc_index++;
+        optd.prev_os = NULL;
 
         /* Skip our locally created empty bytecode first. */
         bc = STAILQ_NEXT(bc, link);
@@ -1335,6 +1484,7 @@ yasm_object_optimize(yasm_object *object, yasm_errwarns *errwarns)
                     /* Remember it as offset setter */
                     os->bc = bc;
                     os->thres = yasm_bc_next_offset(bc);
+                    optd.prev_os = os;
 
                     /* Create new placeholder */
                     os = yasm_xmalloc(sizeof(yasm_offset_setter));
@@ -1423,9 +1573,7 @@ yasm_object_optimize(yasm_object *object, yasm_errwarns *errwarns)
         if (span->rel_term) {
             span->rel_term->cur_val = span->rel_term->new_val;
             if (span->rel_term->precbc2)
-                span->rel_term->new_val =
-                    yasm_bc_next_offset(span->rel_term->precbc2) -
-                    span->bc->offset;
+                span->rel_term->new_val = span_rel_dist(span);
             else
                 span->rel_term->new_val = span->bc->offset -
                     yasm_bc_next_offset(span->rel_term->precbc);
@@ -1537,13 +1685,36 @@ yasm_object_optimize(yasm_object *object, yasm_errwarns *errwarns)
         IT_enumerate(optd.itree, (long)span->bc->bc_index,
                      (long)span->bc->bc_index, &optd, optimize_term_expand);
 
+        offset_diff = optd.len_diff;
+
+        /* The offset-setter preceding the bc just expanded didn't move, but
+         * its length may depend on the following bytecode lengths (branch
+         * padding), so give it a chance to update.
+         */
+        os = span->prev_os;
+        if (os) {
+            long neg_thres_temp;
+
+            orig_len = os->bc->len;
+            retval = yasm_bc_expand(os->bc, 1, (long)os->cur_val,
+                                    (long)os->new_val, &neg_thres_temp,
+                                    (long *)&os->thres);
+            yasm_errwarn_propagate(errwarns, os->bc->line);
+
+            optd.len_diff = os->bc->len - orig_len;
+            if (optd.len_diff != 0) {
+                IT_enumerate(optd.itree, (long)os->bc->bc_index,
+                     (long)os->bc->bc_index, &optd, optimize_term_expand);
+                offset_diff += optd.len_diff;
+            }
+        }
+
         /* Iterate over offset-setters that follow the bc just expanded.
          * Stop iteration if:
          *  - no more offset-setters in this section
          *  - offset-setter didn't move its following offset
          */
         os = span->os;
-        offset_diff = optd.len_diff;
         while (os->bc && os->bc->section == span->bc->section
                && offset_diff != 0) {
             unsigned long old_next_offset = os->cur_val + os->bc->len;
@@ -237,6 +237,31 @@ int yasm_section_is_default(const yasm_section *sect);
 YASM_LIB_DECL
 void yasm_section_set_default(yasm_section *sect, int def);
 
+/** Set the output layout of a section relative to the section preceding it
+ * in the object.  Object formats that place sections at known positions
+ * relative to each other (e.g. flat binary) use this so the optimizer can
+ * size relative references between sections.
+ * \param sect      section
+ * \param follows   nonzero if the section starts directly after the end of
+ *                  the previous section in the object
+ * \param align     alignment of the section start, in bytes; the section
+ *                  alignment is used instead if larger
+ */
+YASM_LIB_DECL
+void yasm_section_set_layout_follows(yasm_section *sect, int follows,
+                                     unsigned long align);
+
+/** Determine if two sections are laid out at fixed positions relative to
+ * each other (up to alignment padding), as set by
+ * yasm_section_set_layout_follows().
+ * \param sect      section
+ * \param other     other section
+ * \return Nonzero if the distance between the sections is known.
+ */
+YASM_LIB_DECL
+int yasm_section_is_layout_linked(const yasm_section *sect,
+                                  const yasm_section *other);
+
 /** Get object owner of a section.
  * \param sect      section
  * \return Object this section is a part of.
@@ -332,6 +357,38 @@ YASM_LIB_DECL
     (yasm_section *sect,
      /*@returned@*/ /*@only@*/ /*@null@*/ yasm_bytecode *bc);
 
+/** Add bytecode to a section directly after another bytecode.
+ * \note Does not make a copy of bc; so don't pass this function static or
+ *       local variables, and discard the bc pointer after calling this
+ *       function.
+ * \param sect          section
+ * \param prevbc        bytecode in sect to insert after
+ * \param bc            bytecode (may be NULL)
+ * \return If bytecode was actually inserted (it wasn't NULL or empty), the
+ *         bytecode; otherwise NULL.
+ */
+YASM_LIB_DECL
+/*@only@*/ /*@null@*/ yasm_bytecode *yasm_section_bcs_insert_after
+    (yasm_section *sect, yasm_bytecode *prevbc,
+     /*@returned@*/ /*@only@*/ /*@null@*/ yasm_bytecode *bc);
+
+/** Align a loop head in a section: the location directly after precbc,
+ * when it is the target of a backward branch.  Labels at that location
+ * are moved after the alignment padding.  Repeated calls for the same
+ * location share the same alignment.
+ * \param sect          section
+ * \param precbc        bytecode preceding the loop head label
+ * \param branch        branch bytecode targeting the loop head
+ * \param boundary      byte alignment (must be a power of two)
+ * \param maxskip       maximum number of bytes to skip
+ * \param code_fill     code fill data (if NULL, 0 is used)
+ */
+YASM_LIB_DECL
+void yasm_section_align_loop_head
+    (yasm_section *sect, yasm_bytecode *precbc,
+     /*@dependent@*/ yasm_bytecode *branch, unsigned long boundary,
+     unsigned long maxskip, /*@null@*/ const unsigned char **code_fill);
+
 /** Traverses all bytecodes in a section, calling a function on each bytecode.
  * \param sect      section
  * \param errwarns  error/warning set (may be NULL)
@@ -74,6 +74,14 @@ struct yasm_symrec {
     unsigned int size;          /* 0 if not user-defined */
     const char *segment;        /* for segmented systems like DOS */
 
+    /* Object format qualifiers given on the global/extern/common
+     * declaration, and the common size; NULL if none.  Nearly every
+     * exported symbol has these, so they're kept here rather than in
+     * associated data.
+     */
+    /*@null@*/ /*@only@*/ yasm_valparamhead *objext_valparams;
+    /*@null@*/ /*@only@*/ yasm_expr *common_size;
+
     /* associated data; NULL if none */
     /*@null@*/ /*@only@*/ yasm__assoc_data *assoc_data;
 };
@@ -93,43 +101,6 @@ struct yasm_symtab {
     int case_sensitive;
 };
 
-static void
-objext_valparams_destroy(void *data)
-{
-    yasm_vps_destroy((yasm_valparamhead *)data);
-}
-
-static void
-objext_valparams_print(void *data, FILE *f, int indent_level)
-{
-    yasm_vps_print((yasm_valparamhead *)data, f);
-}
-
-static yasm_assoc_data_callback objext_valparams_cb = {
-    objext_valparams_destroy,
-    objext_valparams_print
-};
-
-static void
-common_size_destroy(void *data)
-{
-    yasm_expr **e = (yasm_expr **)data;
-    yasm_expr_destroy(*e);
-    yasm_xfree(data);
-}
-
-static void
-common_size_print(void *data, FILE *f, int indent_level)
-{
-    yasm_expr **e = (yasm_expr **)data;
-    yasm_expr_print(*e, f);
-}
-
-static yasm_assoc_data_callback common_size_cb = {
-    common_size_destroy,
-    common_size_print
-};
-
 yasm_symtab *
 yasm_symtab_create(void)
 {
@@ -153,6 +124,10 @@ symrec_destroy_one(/*@only@*/ void *d)
     yasm_xfree(sym->name);
     if (sym->type == SYM_EQU && (sym->status & YASM_SYM_VALUED))
         yasm_expr_destroy(sym->value.expn);
+    if (sym->objext_valparams)
+        yasm_vps_destroy(sym->objext_valparams);
+    if (sym->common_size)
+        yasm_expr_destroy(sym->common_size);
     yasm__assoc_data_destroy(sym->assoc_data);
     yasm_xfree(sym);
 }
@@ -176,6 +151,8 @@ symrec_new_common(/*@keep@*/ char *name, int case_sensitive)
     rec->visibility = YASM_SYM_LOCAL;
     rec->size = 0;
     rec->segment = NULL;
+    rec->objext_valparams = NULL;
+    rec->common_size = NULL;
     rec->assoc_data = NULL;
     return rec;
 }
@@ -557,6 +534,21 @@ yasm_symrec_get_label(const yasm_symrec *sym,
     return 1;
 }
 
+void
+yasm_symrec__move_labels(yasm_bytecode *from, yasm_bytecode *to)
+{
+    size_t i;
+
+    if (!from->symrecs)
+        return;
+    for (i=0; from->symrecs[i]; i++) {
+        from->symrecs[i]->value.precbc = to;
+        yasm_bc__add_symrec(to, from->symrecs[i]);
+    }
+    yasm_xfree(from->symrecs);
+    from->symrecs = NULL;
+}
+
 void
 yasm_symrec_set_size(yasm_symrec *sym, int size)
 {
@@ -604,28 +596,30 @@ void
 yasm_symrec_set_objext_valparams(yasm_symrec *sym,
                                  /*@only@*/ yasm_valparamhead *objext_valparams)
 {
-    yasm_symrec_add_data(sym, &objext_valparams_cb, objext_valparams);
+    if (sym->objext_valparams && sym->objext_valparams != objext_valparams)
+        yasm_vps_destroy(sym->objext_valparams);
+    sym->objext_valparams = objext_valparams;
 }
 
 yasm_valparamhead *
 yasm_symrec_get_objext_valparams(yasm_symrec *sym)
 {
-    return yasm_symrec_get_data(sym, &objext_valparams_cb);
+    return sym->objext_valparams;
 }
 
 void
 yasm_symrec_set_common_size(yasm_symrec *sym,
                             /*@only@*/ yasm_expr *common_size)
 {
-    yasm_expr **ep = yasm_xmalloc(sizeof(yasm_expr *));
-    *ep = common_size;
-    yasm_symrec_add_data(sym, &common_size_cb, ep);
+    if (sym->common_size && sym->common_size != common_size)
+        yasm_expr_destroy(sym->common_size);
+    sym->common_size = common_size;
 }
 
 yasm_expr **
 yasm_symrec_get_common_size(yasm_symrec *sym)
 {
-    return (yasm_expr **)yasm_symrec_get_data(sym, &common_size_cb);
+    return sym->common_size ? &sym->common_size : NULL;
 }
 
 void *
@@ -701,6 +695,18 @@ yasm_symrec_print(const yasm_symrec *sym, FILE *f, int indent_level)
         fprintf(f, "\n");
     }
 
+    if (sym->objext_valparams) {
+        fprintf(f, "%*sObject extended valparams=", indent_level, "");
+        yasm_vps_print(sym->objext_valparams, f);
+        fprintf(f, "\n");
+    }
+
+    if (sym->common_size) {
+        fprintf(f, "%*sCommon size=", indent_level, "");
+        yasm_expr_print(sym->common_size, f);
+        fprintf(f, "\n");
+    }
+
     if (sym->assoc_data) {
         fprintf(f, "%*sAssociated data:\n", indent_level, "");
         yasm__assoc_data_print(sym->assoc_data, f, indent_level+1);
@@ -322,6 +322,14 @@ YASM_LIB_DECL
 int yasm_symrec_get_label(const yasm_symrec *sym,
                           /*@out@*/ yasm_symrec_get_label_bytecodep *precbc);
 
+/** Move all labels located directly after a bytecode to instead be located
+ * directly after another bytecode.  For section use only.
+ * \param from      bytecode currently preceding the labels
+ * \param to        bytecode to precede the labels
+ */
+YASM_LIB_DECL
+void yasm_symrec__move_labels(yasm_bytecode *from, yasm_bytecode *to);
+
 /** Set the size of a symbol.
  * \param sym       symbol
  * \param size      size to be set
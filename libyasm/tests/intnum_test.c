@@ -0,0 +1,127 @@
+/*
+ * yasm_intnum_check_size() range tests
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR AND OTHER CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE AUTHOR OR OTHER CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libyasm/intnum.c"
+
+typedef struct Test_Entry {
+    /* whether input value is created with create_uint (else create_int) */
+    int is_uint;
+
+    /* input value */
+    unsigned long input;
+
+    /* field size in bits */
+    size_t size;
+
+    /* range type (0=unsigned, 1=signed, 2=either) */
+    int rangetype;
+
+    /* correct return value */
+    int result;
+} Test_Entry;
+
+static Test_Entry tests[] = {
+    /* Unsigned fields */
+    {1, 0xFFUL, 8, 0, 1},
+    {1, 0x100UL, 8, 0, 0},
+    {0, (unsigned long)-1L, 8, 0, 0},
+    {1, 0xFFFFFFFFUL, 32, 0, 1},
+    /* Signed fields */
+    {1, 0x7FUL, 8, 1, 1},
+    {1, 0x80UL, 8, 1, 0},
+    {0, (unsigned long)-128L, 8, 1, 1},
+    {0, (unsigned long)-129L, 8, 1, 0},
+    {1, 0UL, 1, 1, 1},
+    {1, 1UL, 1, 1, 0},
+    {1, 0x7FFFFFFFUL, 32, 1, 1},
+    {1, 0x80000000UL, 32, 1, 0},
+    {1, 0xFFFFFFFFUL, 32, 1, 0},
+    {0, (unsigned long)(-0x7FFFFFFFL-1), 32, 1, 1},
+    /* Either signed or unsigned fields */
+    {1, 0xFFUL, 8, 2, 1},
+    {1, 0x100UL, 8, 2, 0},
+    {0, (unsigned long)-128L, 8, 2, 1},
+    {0, (unsigned long)-129L, 8, 2, 0},
+    {1, 0xFFFFFFFFUL, 32, 2, 1},
+    {1, 0x80000000UL, 32, 2, 1},
+};
+
+static char failed[1000];
+static char failmsg[100];
+
+static int
+run_test(Test_Entry *test)
+{
+    yasm_intnum *intn;
+    int result;
+
+    if (test->is_uint)
+        intn = yasm_intnum_create_uint(test->input);
+    else
+        intn = yasm_intnum_create_int((long)test->input);
+
+    result = yasm_intnum_check_size(intn, test->size, 0, test->rangetype);
+    yasm_intnum_destroy(intn);
+    if (result != test->result) {
+        sprintf(failmsg, "%s%lx in %lu bit range %d: expected %d, got %d!",
+                test->is_uint?"":"(int)", test->input,
+                (unsigned long)test->size, test->rangetype, test->result,
+                result);
+        return 1;
+    }
+    return 0;
+}
+
+int
+main(void)
+{
+    int nf = 0;
+    int numtests = sizeof(tests)/sizeof(Test_Entry);
+    int i;
+
+    if (BitVector_Boot() != ErrCode_Ok)
+        return EXIT_FAILURE;
+    yasm_intnum_initialize();
+
+    failed[0] = '\0';
+    printf("Test intnum_test: ");
+    for (i=0; i<numtests; i++) {
+        int fail = run_test(&tests[i]);
+        printf("%c", fail>0 ? 'F':'.');
+        fflush(stdout);
+        if (fail)
+            sprintf(failed, "%s ** F: %s\n", failed, failmsg);
+        nf += fail;
+    }
+
+    yasm_intnum_cleanup();
+
+    printf(" +%d-%d/%d %d%%\n%s",
+           numtests-nf, nf, numtests, 100*(numtests-nf)/numtests, failed);
+    return (nf == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
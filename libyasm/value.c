@@ -540,6 +540,37 @@ yasm_value_finalize(yasm_value *value, yasm_bytecode *precbc)
         }
     }
 
+    /* Handle the common symbol+constant case immediately; after leveling
+     * the constant terms are folded, so this is a two-term ADD.  This
+     * is exactly what the scan below would produce, without the recursion
+     * and the second leveling pass.
+     */
+    if (value->abs->op == YASM_EXPR_ADD && value->abs->numterms == 2
+        && !value->rel) {
+        yasm_expr__item *terms = value->abs->terms;
+        int symterm = -1;
+
+        if (terms[0].type == YASM_EXPR_SYM && terms[1].type == YASM_EXPR_INT)
+            symterm = 0;
+        else if (terms[0].type == YASM_EXPR_INT
+                 && terms[1].type == YASM_EXPR_SYM)
+            symterm = 1;
+
+        if (symterm >= 0) {
+            value->rel = terms[symterm].data.sym;
+            if (yasm_intnum_is_zero(terms[1-symterm].data.intn)) {
+                yasm_expr_destroy(value->abs);
+                value->abs = NULL;
+            } else {
+                if (symterm == 0)
+                    terms[0] = terms[1];    /* structure copy */
+                value->abs->numterms = 1;
+                value->abs->op = YASM_EXPR_IDENT;
+            }
+            return 0;
+        }
+    }
+
     if (value_finalize_scan(value, value->abs, precbc, 0))
         return 1;
 
@@ -632,7 +663,14 @@ yasm_value_output_basic(yasm_value *value, /*@out@*/ unsigned char *buf,
     if (value->no_warn)
         warn = 0;
 
-    if (value->abs) {
+    if (value->abs && value->abs->op == YASM_EXPR_IDENT
+        && value->abs->terms[0].type == YASM_EXPR_INT) {
+        /* Already reduced to a plain integer (the usual case for values
+         * that were resolved during optimization): no need to simplify
+         * or scan the expression again.
+         */
+        intn = value->abs->terms[0].data.intn;
+    } else if (value->abs) {
         /* Handle floating point expressions */
         if (!value->rel && value->abs->op == YASM_EXPR_IDENT
             && value->abs->terms[0].type == YASM_EXPR_FLOAT) {
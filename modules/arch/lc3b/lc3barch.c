@@ -81,6 +81,18 @@ lc3b_set_var(yasm_arch *arch, const char *var, unsigned long val)
     return 1;
 }
 
+static int
+lc3b_get_var(const yasm_arch *arch, const char *var, unsigned long *val)
+{
+    return 1;
+}
+
+static void
+lc3b_print_insn_stats(yasm_arch *arch, yasm_object *object, FILE *f,
+                      int json)
+{
+}
+
 static const unsigned char **
 lc3b_get_fill(const yasm_arch *arch)
 {
@@ -192,6 +204,8 @@ yasm_arch_module yasm_lc3b_LTX_arch = {
     lc3b_get_machine,
     lc3b_get_address_size,
     lc3b_set_var,
+    lc3b_get_var,
+    lc3b_print_insn_stats,
     yasm_lc3b__parse_check_insnprefix,
     yasm_lc3b__parse_check_regtmod,
     lc3b_get_fill,
@@ -40,7 +40,9 @@ ordered_cpu_features = [
     "AVX", "FMA", "AES", "CLMUL", "MOVBE", "XOP", "FMA4", "F16C",
     "FSGSBASE", "RDRAND", "XSAVEOPT", "EPTVPID", "SMX", "AVX2", "BMI1",
     "BMI2", "INVPCID", "LZCNT", "TBM", "TSX", "SHA", "SMAP", "RDSEED", "ADX",
-    "PRFCHW"]
+    "PRFCHW", "AVX512F", "AVX512CD", "AVX512BW", "AVX512DQ", "AVX512VL",
+    "VAES", "VPCLMULQDQ", "GFNI", "AVXVNNI", "AVXIFMA", "MOVDIRI",
+    "SERIALIZE"]
 unordered_cpu_features = ["Priv", "Prot", "Undoc", "Obs"]
 
 # Predefined VEX prefix field values
@@ -163,6 +165,9 @@ class GroupForm(object):
         if kwargs.pop("notavx", False):
             self.misc_flags.add("NOT_AVX")
 
+        # AVX-512 operand decorators accepted
+        self.evex_flags = set(kwargs.pop("evex_flags", []))
+
         # Operation size
         self.opersize = kwargs.pop("opersize", 0)
         if self.opersize == 8:
@@ -227,6 +232,33 @@ class GroupForm(object):
 
             self.special_prefix = "0x%02X" % (0xC0 + vexW*8 + vexL*4 + vexpp)
 
+        # EVEX prefix
+        if "evex" in kwargs:
+            self.misc_flags.add("ONLY_AVX")
+            evexW = kwargs.pop("evexw", 0)
+            if evexW not in [0, 1]:
+                raise ValueError("EVEX.W must be 0 or 1")
+
+            evexL = kwargs.pop("evex")
+            if evexL not in [128, 256, 512]:
+                raise ValueError("EVEX.L'L must be 128, 256, or 512")
+            evexL = [128, 256, 512].index(evexL)
+
+            if self.special_prefix in ["0", "0x00"]:
+                evexpp = 0
+            elif self.special_prefix == "0x66":
+                evexpp = 1
+            elif self.special_prefix == "0xF3":
+                evexpp = 2
+            elif self.special_prefix == "0xF2":
+                evexpp = 3
+            else:
+                raise ValueError("Cannot combine EVEX and special prefix %s"
+                                 % self.special_prefix)
+
+            self.special_prefix = "0x%02X" % (0xA0 + evexW*16 + evexL*4 +
+                                              evexpp)
+
         # XOP prefix
         if "xop" in kwargs:
             xopW = kwargs.pop("xopw", 0)
@@ -355,6 +387,9 @@ class GroupForm(object):
         # Build instruction info structure initializer
         return "{ "+ ", ".join([gas_flags or "0",
                                 "|".join(self.misc_flags) or "0",
+                                "|".join("EVEX_%s" % x
+                                         for x in sorted(self.evex_flags))
+                                    or "0",
                                 cpus_str[0],
                                 cpus_str[1],
                                 cpus_str[2],
@@ -3994,42 +4029,42 @@ add_insn("pxor",      "mmxsse2", modifiers=[0xEF])
 
 # AVX versions don't support the MMX registers
 add_insn("vpackssdw",  "xmm_xmm128_256avx2", modifiers=[0x66, 0x6B, VEXL0], avx=True)
-add_insn("vpacksswb",  "xmm_xmm128_256avx2", modifiers=[0x66, 0x63, VEXL0], avx=True)
-add_insn("vpackuswb",  "xmm_xmm128_256avx2", modifiers=[0x66, 0x67, VEXL0], avx=True)
-add_insn("vpaddb",     "xmm_xmm128_256avx2", modifiers=[0x66, 0xFC, VEXL0], avx=True)
-add_insn("vpaddw",     "xmm_xmm128_256avx2", modifiers=[0x66, 0xFD, VEXL0], avx=True)
-add_insn("vpaddd",     "xmm_xmm128_256avx2", modifiers=[0x66, 0xFE, VEXL0], avx=True)
-add_insn("vpaddq",     "xmm_xmm128_256avx2", modifiers=[0x66, 0xD4, VEXL0], avx=True)
-add_insn("vpaddsb",    "xmm_xmm128_256avx2", modifiers=[0x66, 0xEC, VEXL0], avx=True)
-add_insn("vpaddsw",    "xmm_xmm128_256avx2", modifiers=[0x66, 0xED, VEXL0], avx=True)
-add_insn("vpaddusb",   "xmm_xmm128_256avx2", modifiers=[0x66, 0xDC, VEXL0], avx=True)
-add_insn("vpaddusw",   "xmm_xmm128_256avx2", modifiers=[0x66, 0xDD, VEXL0], avx=True)
+add_insn("vpacksswb",  "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0x63, VEXL0], avx=True)
+add_insn("vpackuswb",  "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0x67, VEXL0], avx=True)
+add_insn("vpaddb",     "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xFC, VEXL0], avx=True)
+add_insn("vpaddw",     "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xFD, VEXL0], avx=True)
+add_insn("vpaddd",     "xmm_xmm128_256avx2_d", modifiers=[0x66, 0xFE, VEXL0], avx=True)
+add_insn("vpaddq",     "xmm_xmm128_256avx2_q", modifiers=[0x66, 0xD4, VEXL0], avx=True)
+add_insn("vpaddsb",    "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xEC, VEXL0], avx=True)
+add_insn("vpaddsw",    "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xED, VEXL0], avx=True)
+add_insn("vpaddusb",   "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xDC, VEXL0], avx=True)
+add_insn("vpaddusw",   "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xDD, VEXL0], avx=True)
 add_insn("vpand",      "xmm_xmm128_256avx2", modifiers=[0x66, 0xDB, VEXL0], avx=True)
 add_insn("vpandn",     "xmm_xmm128_256avx2", modifiers=[0x66, 0xDF, VEXL0], avx=True)
-add_insn("vpcmpeqb",   "xmm_xmm128_256avx2", modifiers=[0x66, 0x74, VEXL0], avx=True)
-add_insn("vpcmpeqw",   "xmm_xmm128_256avx2", modifiers=[0x66, 0x75, VEXL0], avx=True)
-add_insn("vpcmpeqd",   "xmm_xmm128_256avx2", modifiers=[0x66, 0x76, VEXL0], avx=True)
-add_insn("vpcmpgtb",   "xmm_xmm128_256avx2", modifiers=[0x66, 0x64, VEXL0], avx=True)
-add_insn("vpcmpgtw",   "xmm_xmm128_256avx2", modifiers=[0x66, 0x65, VEXL0], avx=True)
-add_insn("vpcmpgtd",   "xmm_xmm128_256avx2", modifiers=[0x66, 0x66, VEXL0], avx=True)
-add_insn("vpmaddwd",   "xmm_xmm128_256avx2", modifiers=[0x66, 0xF5, VEXL0], avx=True)
-add_insn("vpmulhw",    "xmm_xmm128_256avx2", modifiers=[0x66, 0xE5, VEXL0], avx=True)
-add_insn("vpmullw",    "xmm_xmm128_256avx2", modifiers=[0x66, 0xD5, VEXL0], avx=True)
+add_insn("vpcmpeqb",   "xmm_xmm128_256avx2_kbw", modifiers=[0x66, 0x74, VEXL0], avx=True)
+add_insn("vpcmpeqw",   "xmm_xmm128_256avx2_kbw", modifiers=[0x66, 0x75, VEXL0], avx=True)
+add_insn("vpcmpeqd",   "xmm_xmm128_256avx2_k", modifiers=[0x66, 0x76, VEXL0], avx=True)
+add_insn("vpcmpgtb",   "xmm_xmm128_256avx2_kbw", modifiers=[0x66, 0x64, VEXL0], avx=True)
+add_insn("vpcmpgtw",   "xmm_xmm128_256avx2_kbw", modifiers=[0x66, 0x65, VEXL0], avx=True)
+add_insn("vpcmpgtd",   "xmm_xmm128_256avx2_k", modifiers=[0x66, 0x66, VEXL0], avx=True)
+add_insn("vpmaddwd",   "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xF5, VEXL0], avx=True)
+add_insn("vpmulhw",    "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xE5, VEXL0], avx=True)
+add_insn("vpmullw",    "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xD5, VEXL0], avx=True)
 add_insn("vpor",       "xmm_xmm128_256avx2", modifiers=[0x66, 0xEB, VEXL0], avx=True)
-add_insn("vpsubb",     "xmm_xmm128_256avx2", modifiers=[0x66, 0xF8, VEXL0], avx=True)
-add_insn("vpsubw",     "xmm_xmm128_256avx2", modifiers=[0x66, 0xF9, VEXL0], avx=True)
-add_insn("vpsubd",     "xmm_xmm128_256avx2", modifiers=[0x66, 0xFA, VEXL0], avx=True)
-add_insn("vpsubq",     "xmm_xmm128_256avx2", modifiers=[0x66, 0xFB, VEXL0], avx=True)
-add_insn("vpsubsb",    "xmm_xmm128_256avx2", modifiers=[0x66, 0xE8, VEXL0], avx=True)
-add_insn("vpsubsw",    "xmm_xmm128_256avx2", modifiers=[0x66, 0xE9, VEXL0], avx=True)
-add_insn("vpsubusb",   "xmm_xmm128_256avx2", modifiers=[0x66, 0xD8, VEXL0], avx=True)
-add_insn("vpsubusw",   "xmm_xmm128_256avx2", modifiers=[0x66, 0xD9, VEXL0], avx=True)
-add_insn("vpunpckhbw", "xmm_xmm128_256avx2", modifiers=[0x66, 0x68, VEXL0], avx=True)
-add_insn("vpunpckhwd", "xmm_xmm128_256avx2", modifiers=[0x66, 0x69, VEXL0], avx=True)
-add_insn("vpunpckhdq", "xmm_xmm128_256avx2", modifiers=[0x66, 0x6A, VEXL0], avx=True)
-add_insn("vpunpcklbw", "xmm_xmm128_256avx2", modifiers=[0x66, 0x60, VEXL0], avx=True)
-add_insn("vpunpcklwd", "xmm_xmm128_256avx2", modifiers=[0x66, 0x61, VEXL0], avx=True)
-add_insn("vpunpckldq", "xmm_xmm128_256avx2", modifiers=[0x66, 0x62, VEXL0], avx=True)
+add_insn("vpsubb",     "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xF8, VEXL0], avx=True)
+add_insn("vpsubw",     "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xF9, VEXL0], avx=True)
+add_insn("vpsubd",     "xmm_xmm128_256avx2_d", modifiers=[0x66, 0xFA, VEXL0], avx=True)
+add_insn("vpsubq",     "xmm_xmm128_256avx2_q", modifiers=[0x66, 0xFB, VEXL0], avx=True)
+add_insn("vpsubsb",    "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xE8, VEXL0], avx=True)
+add_insn("vpsubsw",    "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xE9, VEXL0], avx=True)
+add_insn("vpsubusb",   "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xD8, VEXL0], avx=True)
+add_insn("vpsubusw",   "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xD9, VEXL0], avx=True)
+add_insn("vpunpckhbw", "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0x68, VEXL0], avx=True)
+add_insn("vpunpckhwd", "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0x69, VEXL0], avx=True)
+add_insn("vpunpckhdq", "xmm_xmm128_256avx2_d", modifiers=[0x66, 0x6A, VEXL0], avx=True)
+add_insn("vpunpcklbw", "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0x60, VEXL0], avx=True)
+add_insn("vpunpcklwd", "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0x61, VEXL0], avx=True)
+add_insn("vpunpckldq", "xmm_xmm128_256avx2_d", modifiers=[0x66, 0x62, VEXL0], avx=True)
 add_insn("vpxor",      "xmm_xmm128_256avx2", modifiers=[0x66, 0xEF, VEXL0], avx=True)
 
 add_group("pshift",
@@ -4109,14 +4144,14 @@ for cpu, sz in zip(["AVX", "AVX2"], [128, 256]):
                   Operand(type="SIMDReg", size=sz, dest="EA"),
                   Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
-add_insn("vpsllw", "vpshift", modifiers=[0xF1, 0x71, 6])
-add_insn("vpslld", "vpshift", modifiers=[0xF2, 0x72, 6])
-add_insn("vpsllq", "vpshift", modifiers=[0xF3, 0x73, 6])
-add_insn("vpsraw", "vpshift", modifiers=[0xE1, 0x71, 4])
-add_insn("vpsrad", "vpshift", modifiers=[0xE2, 0x72, 4])
-add_insn("vpsrlw", "vpshift", modifiers=[0xD1, 0x71, 2])
-add_insn("vpsrld", "vpshift", modifiers=[0xD2, 0x72, 2])
-add_insn("vpsrlq", "vpshift", modifiers=[0xD3, 0x73, 2])
+add_insn("vpsllw", "vpshift_w", modifiers=[0xF1, 0x71, 6])
+add_insn("vpslld", "vpshift_d", modifiers=[0xF2, 0x72, 6])
+add_insn("vpsllq", "vpshift_q", modifiers=[0xF3, 0x73, 6])
+add_insn("vpsraw", "vpshift_w", modifiers=[0xE1, 0x71, 4])
+add_insn("vpsrad", "vpshift_d", modifiers=[0xE2, 0x72, 4])
+add_insn("vpsrlw", "vpshift_w", modifiers=[0xD1, 0x71, 2])
+add_insn("vpsrld", "vpshift_d", modifiers=[0xD2, 0x72, 2])
+add_insn("vpsrlq", "vpshift_q", modifiers=[0xD3, 0x73, 2])
 
 #
 # PIII (Katmai) new instructions / SIMD instructions
@@ -4131,13 +4166,13 @@ add_insn("pmulhuw", "mmxsse2", modifiers=[0xE4], cpu=["P3", "MMX"])
 add_insn("psadbw",  "mmxsse2", modifiers=[0xF6], cpu=["P3", "MMX"])
 
 # AVX versions don't support MMX register
-add_insn("vpavgb",   "xmm_xmm128_256avx2", modifiers=[0x66, 0xE0, VEXL0], avx=True)
-add_insn("vpavgw",   "xmm_xmm128_256avx2", modifiers=[0x66, 0xE3, VEXL0], avx=True)
-add_insn("vpmaxsw",  "xmm_xmm128_256avx2", modifiers=[0x66, 0xEE, VEXL0], avx=True)
-add_insn("vpmaxub",  "xmm_xmm128_256avx2", modifiers=[0x66, 0xDE, VEXL0], avx=True)
-add_insn("vpminsw",  "xmm_xmm128_256avx2", modifiers=[0x66, 0xEA, VEXL0], avx=True)
-add_insn("vpminub",  "xmm_xmm128_256avx2", modifiers=[0x66, 0xDA, VEXL0], avx=True)
-add_insn("vpmulhuw", "xmm_xmm128_256avx2", modifiers=[0x66, 0xE4, VEXL0], avx=True)
+add_insn("vpavgb",   "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xE0, VEXL0], avx=True)
+add_insn("vpavgw",   "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xE3, VEXL0], avx=True)
+add_insn("vpmaxsw",  "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xEE, VEXL0], avx=True)
+add_insn("vpmaxub",  "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xDE, VEXL0], avx=True)
+add_insn("vpminsw",  "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xEA, VEXL0], avx=True)
+add_insn("vpminub",  "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xDA, VEXL0], avx=True)
+add_insn("vpmulhuw", "xmm_xmm128_256avx2_bw", modifiers=[0x66, 0xE4, VEXL0], avx=True)
 add_insn("vpsadbw",  "xmm_xmm128_256avx2", modifiers=[0x66, 0xF6, VEXL0], avx=True)
 
 add_insn("prefetchnta", "twobytemem", modifiers=[0, 0x0F, 0x18], cpu=["P3"])
@@ -4250,19 +4285,19 @@ add_insn("unpckhps", "xmm_xmm128", modifiers=[0, 0x15])
 add_insn("unpcklps", "xmm_xmm128", modifiers=[0, 0x14])
 add_insn("xorps",    "xmm_xmm128", modifiers=[0, 0x57])
 
-add_insn("vaddps",    "xmm_xmm128_256", modifiers=[0, 0x58, VEXL0], avx=True)
-add_insn("vandnps",   "xmm_xmm128_256", modifiers=[0, 0x55, VEXL0], avx=True)
-add_insn("vandps",    "xmm_xmm128_256", modifiers=[0, 0x54, VEXL0], avx=True)
-add_insn("vdivps",    "xmm_xmm128_256", modifiers=[0, 0x5E, VEXL0], avx=True)
-add_insn("vmaxps",    "xmm_xmm128_256", modifiers=[0, 0x5F, VEXL0], avx=True)
-add_insn("vminps",    "xmm_xmm128_256", modifiers=[0, 0x5D, VEXL0], avx=True)
-add_insn("vmulps",    "xmm_xmm128_256", modifiers=[0, 0x59, VEXL0], avx=True)
-add_insn("vorps",     "xmm_xmm128_256", modifiers=[0, 0x56, VEXL0], avx=True)
+add_insn("vaddps",    "xmm_xmm128_256_ps_er", modifiers=[0, 0x58, VEXL0], avx=True)
+add_insn("vandnps",   "xmm_xmm128_256_ps_dq", modifiers=[0, 0x55, VEXL0], avx=True)
+add_insn("vandps",    "xmm_xmm128_256_ps_dq", modifiers=[0, 0x54, VEXL0], avx=True)
+add_insn("vdivps",    "xmm_xmm128_256_ps_er", modifiers=[0, 0x5E, VEXL0], avx=True)
+add_insn("vmaxps",    "xmm_xmm128_256_ps_sae", modifiers=[0, 0x5F, VEXL0], avx=True)
+add_insn("vminps",    "xmm_xmm128_256_ps_sae", modifiers=[0, 0x5D, VEXL0], avx=True)
+add_insn("vmulps",    "xmm_xmm128_256_ps_er", modifiers=[0, 0x59, VEXL0], avx=True)
+add_insn("vorps",     "xmm_xmm128_256_ps_dq", modifiers=[0, 0x56, VEXL0], avx=True)
 # vrcpps, vrsqrtps, and vsqrtps don't add third operand
-add_insn("vsubps",    "xmm_xmm128_256", modifiers=[0, 0x5C, VEXL0], avx=True)
-add_insn("vunpckhps", "xmm_xmm128_256", modifiers=[0, 0x15, VEXL0], avx=True)
-add_insn("vunpcklps", "xmm_xmm128_256", modifiers=[0, 0x14, VEXL0], avx=True)
-add_insn("vxorps",    "xmm_xmm128_256", modifiers=[0, 0x57, VEXL0], avx=True)
+add_insn("vsubps",    "xmm_xmm128_256_ps_er", modifiers=[0, 0x5C, VEXL0], avx=True)
+add_insn("vunpckhps", "xmm_xmm128_256_ps_f", modifiers=[0, 0x15, VEXL0], avx=True)
+add_insn("vunpcklps", "xmm_xmm128_256_ps_f", modifiers=[0, 0x14, VEXL0], avx=True)
+add_insn("vxorps",    "xmm_xmm128_256_ps_dq", modifiers=[0, 0x57, VEXL0], avx=True)
 
 add_group("cvt_rx_xmm32",
     suffix="l",
@@ -4393,7 +4428,7 @@ add_group("cvt_xmm_rmx",
               Operand(type="RM", size=64, dest="EA")])
 
 add_insn("cvtsi2ss", "cvt_xmm_rmx", modifiers=[0xF3, 0x2A])
-add_insn("vcvtsi2ss", "cvt_xmm_rmx", modifiers=[0xF3, 0x2A, VEXL0], avx=True)
+add_insn("vcvtsi2ss", "cvt_xmm_rmx_ss", modifiers=[0xF3, 0x2A, VEXL0], avx=True)
 
 add_group("xmm_xmm32",
     cpu=["SSE"],
@@ -4440,16 +4475,16 @@ add_insn("sqrtss",  "xmm_xmm32", modifiers=[0xF3, 0x51])
 add_insn("subss",   "xmm_xmm32", modifiers=[0xF3, 0x5C])
 add_insn("ucomiss", "xmm_xmm32", modifiers=[0, 0x2E])
 
-add_insn("vaddss",   "xmm_xmm32", modifiers=[0xF3, 0x58, VEXL0], avx=True)
+add_insn("vaddss",   "xmm_xmm32_er", modifiers=[0xF3, 0x58, VEXL0], avx=True)
 # vcomiss and vucomiss are only two operand
-add_insn("vdivss",   "xmm_xmm32", modifiers=[0xF3, 0x5E, VEXL0], avx=True)
-add_insn("vmaxss",   "xmm_xmm32", modifiers=[0xF3, 0x5F, VEXL0], avx=True)
-add_insn("vminss",   "xmm_xmm32", modifiers=[0xF3, 0x5D, VEXL0], avx=True)
-add_insn("vmulss",   "xmm_xmm32", modifiers=[0xF3, 0x59, VEXL0], avx=True)
+add_insn("vdivss",   "xmm_xmm32_er", modifiers=[0xF3, 0x5E, VEXL0], avx=True)
+add_insn("vmaxss",   "xmm_xmm32_sae", modifiers=[0xF3, 0x5F, VEXL0], avx=True)
+add_insn("vminss",   "xmm_xmm32_sae", modifiers=[0xF3, 0x5D, VEXL0], avx=True)
+add_insn("vmulss",   "xmm_xmm32_er", modifiers=[0xF3, 0x59, VEXL0], avx=True)
 add_insn("vrcpss",   "xmm_xmm32", modifiers=[0xF3, 0x53, VEXL0], avx=True)
 add_insn("vrsqrtss", "xmm_xmm32", modifiers=[0xF3, 0x52, VEXL0], avx=True)
-add_insn("vsqrtss",  "xmm_xmm32", modifiers=[0xF3, 0x51, VEXL0], avx=True)
-add_insn("vsubss",   "xmm_xmm32", modifiers=[0xF3, 0x5C, VEXL0], avx=True)
+add_insn("vsqrtss",  "xmm_xmm32_er", modifiers=[0xF3, 0x51, VEXL0], avx=True)
+add_insn("vsubss",   "xmm_xmm32_er", modifiers=[0xF3, 0x5C, VEXL0], avx=True)
 
 add_group("ssecmp_128",
     cpu=["SSE"],
@@ -4610,8 +4645,8 @@ add_group("xmm_xmm128_imm_256",
               Operand(type="SIMDRM", size=256, relaxed=True, dest="EA"),
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
-add_insn("vcmpps", "xmm_xmm128_imm_256", modifiers=[0, 0xC2, VEXL0], avx=True)
-add_insn("vshufps", "xmm_xmm128_imm_256", modifiers=[0, 0xC6, VEXL0], avx=True)
+add_insn("vcmpps", "xmm_xmm128_imm_256_kps", modifiers=[0, 0xC2, VEXL0], avx=True)
+add_insn("vshufps", "xmm_xmm128_imm_256_ps", modifiers=[0, 0xC6, VEXL0], avx=True)
 
 add_group("xmm_xmm32_imm",
     cpu=["SSE"],
@@ -4722,8 +4757,8 @@ add_group("movau",
 
 add_insn("movaps", "movau", modifiers=[0, 0x28, 0x01])
 add_insn("movups", "movau", modifiers=[0, 0x10, 0x01])
-add_insn("vmovaps", "movau", modifiers=[0, 0x28, 0x01], avx=True)
-add_insn("vmovups", "movau", modifiers=[0, 0x10, 0x01], avx=True)
+add_insn("vmovaps", "movau_ps", modifiers=[0, 0x28, 0x01], avx=True)
+add_insn("vmovups", "movau_ps", modifiers=[0, 0x10, 0x01], avx=True)
 
 add_group("movhllhps",
     cpu=["SSE"],
@@ -4939,7 +4974,7 @@ add_group("pextrw",
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
 add_insn("pextrw", "pextrw")
-add_insn("vpextrw", "pextrw", modifiers=[VEXL0], avx=True)
+add_insn("vpextrw", "pextrw_bw", modifiers=[VEXL0], avx=True)
 
 add_group("pinsrw",
     suffix="l",
@@ -5030,7 +5065,7 @@ add_group("pinsrw",
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
 add_insn("pinsrw", "pinsrw")
-add_insn("vpinsrw", "pinsrw", modifiers=[VEXL0], avx=True)
+add_insn("vpinsrw", "pinsrw_bw", modifiers=[VEXL0], avx=True)
 
 add_group("pmovmskb",
     suffix="l",
@@ -5146,16 +5181,16 @@ add_insn("subsd",    "xmm_xmm64", modifiers=[0xF2, 0x5C])
 add_insn("sqrtsd",   "xmm_xmm64", modifiers=[0xF2, 0x51])
 add_insn("ucomisd",  "xmm_xmm64", modifiers=[0x66, 0x2E])
 
-add_insn("vaddsd",    "xmm_xmm64", modifiers=[0xF2, 0x58, VEXL0], avx=True)
+add_insn("vaddsd",    "xmm_xmm64_er", modifiers=[0xF2, 0x58, VEXL0], avx=True)
 # vcomisd and vucomisd are only two operand
 # vcvtdq2pd and vcvtps2pd can take ymm, xmm version
-add_insn("vcvtsd2ss", "xmm_xmm64", modifiers=[0xF2, 0x5A, VEXL0], avx=True)
-add_insn("vdivsd",    "xmm_xmm64", modifiers=[0xF2, 0x5E, VEXL0], avx=True)
-add_insn("vmaxsd",    "xmm_xmm64", modifiers=[0xF2, 0x5F, VEXL0], avx=True)
-add_insn("vminsd",    "xmm_xmm64", modifiers=[0xF2, 0x5D, VEXL0], avx=True)
-add_insn("vmulsd",    "xmm_xmm64", modifiers=[0xF2, 0x59, VEXL0], avx=True)
-add_insn("vsubsd",    "xmm_xmm64", modifiers=[0xF2, 0x5C, VEXL0], avx=True)
-add_insn("vsqrtsd",   "xmm_xmm64", modifiers=[0xF2, 0x51, VEXL0], avx=True)
+add_insn("vcvtsd2ss", "xmm_xmm64_er", modifiers=[0xF2, 0x5A, VEXL0], avx=True)
+add_insn("vdivsd",    "xmm_xmm64_er", modifiers=[0xF2, 0x5E, VEXL0], avx=True)
+add_insn("vmaxsd",    "xmm_xmm64_sae", modifiers=[0xF2, 0x5F, VEXL0], avx=True)
+add_insn("vminsd",    "xmm_xmm64_sae", modifiers=[0xF2, 0x5D, VEXL0], avx=True)
+add_insn("vmulsd",    "xmm_xmm64_er", modifiers=[0xF2, 0x59, VEXL0], avx=True)
+add_insn("vsubsd",    "xmm_xmm64_er", modifiers=[0xF2, 0x5C, VEXL0], avx=True)
+add_insn("vsqrtsd",   "xmm_xmm64_er", modifiers=[0xF2, 0x51, VEXL0], avx=True)
 
 add_insn("addpd",    "xmm_xmm128", modifiers=[0x66, 0x58], cpu=["SSE2"])
 add_insn("andnpd",   "xmm_xmm128", modifiers=[0x66, 0x55], cpu=["SSE2"])
@@ -5175,21 +5210,21 @@ add_insn("unpckhpd", "xmm_xmm128", modifiers=[0x66, 0x15], cpu=["SSE2"])
 add_insn("unpcklpd", "xmm_xmm128", modifiers=[0x66, 0x14], cpu=["SSE2"])
 add_insn("xorpd",    "xmm_xmm128", modifiers=[0x66, 0x57], cpu=["SSE2"])
 
-add_insn("vaddpd",    "xmm_xmm128_256", modifiers=[0x66, 0x58, VEXL0], avx=True)
-add_insn("vandnpd",   "xmm_xmm128_256", modifiers=[0x66, 0x55, VEXL0], avx=True)
-add_insn("vandpd",    "xmm_xmm128_256", modifiers=[0x66, 0x54, VEXL0], avx=True)
+add_insn("vaddpd",    "xmm_xmm128_256_pd_er", modifiers=[0x66, 0x58, VEXL0], avx=True)
+add_insn("vandnpd",   "xmm_xmm128_256_pd_dq", modifiers=[0x66, 0x55, VEXL0], avx=True)
+add_insn("vandpd",    "xmm_xmm128_256_pd_dq", modifiers=[0x66, 0x54, VEXL0], avx=True)
 # vcvtdq2ps and vcvtps2dq are 2-operand, YMM capable
 # vcvtpd2dq and vcvtpd2ps take xmm, ymm combination
-add_insn("vdivpd",    "xmm_xmm128_256", modifiers=[0x66, 0x5E, VEXL0], avx=True)
-add_insn("vmaxpd",    "xmm_xmm128_256", modifiers=[0x66, 0x5F, VEXL0], avx=True)
-add_insn("vminpd",    "xmm_xmm128_256", modifiers=[0x66, 0x5D, VEXL0], avx=True)
-add_insn("vmulpd",    "xmm_xmm128_256", modifiers=[0x66, 0x59, VEXL0], avx=True)
-add_insn("vorpd",     "xmm_xmm128_256", modifiers=[0x66, 0x56, VEXL0], avx=True)
+add_insn("vdivpd",    "xmm_xmm128_256_pd_er", modifiers=[0x66, 0x5E, VEXL0], avx=True)
+add_insn("vmaxpd",    "xmm_xmm128_256_pd_sae", modifiers=[0x66, 0x5F, VEXL0], avx=True)
+add_insn("vminpd",    "xmm_xmm128_256_pd_sae", modifiers=[0x66, 0x5D, VEXL0], avx=True)
+add_insn("vmulpd",    "xmm_xmm128_256_pd_er", modifiers=[0x66, 0x59, VEXL0], avx=True)
+add_insn("vorpd",     "xmm_xmm128_256_pd_dq", modifiers=[0x66, 0x56, VEXL0], avx=True)
 # vsqrtpd doesn't add third operand
-add_insn("vsubpd",    "xmm_xmm128_256", modifiers=[0x66, 0x5C, VEXL0], avx=True)
-add_insn("vunpckhpd", "xmm_xmm128_256", modifiers=[0x66, 0x15, VEXL0], avx=True)
-add_insn("vunpcklpd", "xmm_xmm128_256", modifiers=[0x66, 0x14, VEXL0], avx=True)
-add_insn("vxorpd",    "xmm_xmm128_256", modifiers=[0x66, 0x57, VEXL0], avx=True)
+add_insn("vsubpd",    "xmm_xmm128_256_pd_er", modifiers=[0x66, 0x5C, VEXL0], avx=True)
+add_insn("vunpckhpd", "xmm_xmm128_256_pd_f", modifiers=[0x66, 0x15, VEXL0], avx=True)
+add_insn("vunpcklpd", "xmm_xmm128_256_pd_f", modifiers=[0x66, 0x14, VEXL0], avx=True)
+add_insn("vxorpd",    "xmm_xmm128_256_pd_dq", modifiers=[0x66, 0x57, VEXL0], avx=True)
 
 add_group("ssecmp_64",
     cpu=["SSE2"],
@@ -5234,11 +5269,11 @@ for ib, cc in avxcoms:
 
 add_insn("cmppd",  "xmm_xmm128_imm", modifiers=[0x66, 0xC2], cpu=["SSE2"])
 add_insn("shufpd", "xmm_xmm128_imm", modifiers=[0x66, 0xC6], cpu=["SSE2"])
-add_insn("vcmppd",  "xmm_xmm128_imm_256", modifiers=[0x66, 0xC2, VEXL0], avx=True)
-add_insn("vshufpd", "xmm_xmm128_imm_256", modifiers=[0x66, 0xC6, VEXL0], avx=True)
+add_insn("vcmppd",  "xmm_xmm128_imm_256_kpd", modifiers=[0x66, 0xC2, VEXL0], avx=True)
+add_insn("vshufpd", "xmm_xmm128_imm_256_pd", modifiers=[0x66, 0xC6, VEXL0], avx=True)
 
 add_insn("cvtsi2sd", "cvt_xmm_rmx", modifiers=[0xF2, 0x2A], cpu=["SSE2"])
-add_insn("vcvtsi2sd", "cvt_xmm_rmx", modifiers=[0xF2, 0x2A, VEXL0], avx=True)
+add_insn("vcvtsi2sd", "cvt_xmm_rmx_sd", modifiers=[0xF2, 0x2A, VEXL0], avx=True)
 
 add_group("cvt_rx_xmm64",
     suffix="l",
@@ -5340,8 +5375,8 @@ add_insn("vcmpsd", "cmpsd", modifiers=[VEXL0], avx=True)
 
 add_insn("movapd", "movau", modifiers=[0x66, 0x28, 0x01], cpu=["SSE2"])
 add_insn("movupd", "movau", modifiers=[0x66, 0x10, 0x01], cpu=["SSE2"])
-add_insn("vmovapd", "movau", modifiers=[0x66, 0x28, 0x01], avx=True)
-add_insn("vmovupd", "movau", modifiers=[0x66, 0x10, 0x01], avx=True)
+add_insn("vmovapd", "movau_pd", modifiers=[0x66, 0x28, 0x01], avx=True)
+add_insn("vmovupd", "movau_pd", modifiers=[0x66, 0x10, 0x01], avx=True)
 
 add_insn("movhpd", "movhlp", modifiers=[0x66, 0x16], cpu=["SSE2"])
 add_insn("movlpd", "movhlp", modifiers=[0x66, 0x12], cpu=["SSE2"])
@@ -5494,15 +5529,15 @@ add_insn("punpcklqdq", "xmm_xmm128", modifiers=[0x66, 0x6C], cpu=["SSE2"])
 add_insn("vcvttsd2si", "cvt_rx_xmm64", modifiers=[0xF2, 0x2C, VEXL0], avx=True)
 # vcvttpd2dq takes xmm, ymm combination
 # vcvttps2dq is two-operand
-add_insn("vpmuludq", "xmm_xmm128_256avx2", modifiers=[0x66, 0xF4, VEXL0], avx=True)
-add_insn("vpshufd", "xmm_xmm128_imm_256avx2", modifiers=[0x66, 0x70, VEXL0], avx=True)
-add_insn("vpshufhw", "xmm_xmm128_imm_256avx2", modifiers=[0xF3, 0x70, VEXL0], avx=True)
-add_insn("vpshuflw", "xmm_xmm128_imm_256avx2", modifiers=[0xF2, 0x70, VEXL0], avx=True)
-add_insn("vpunpckhqdq", "xmm_xmm128_256avx2", modifiers=[0x66, 0x6D, VEXL0], avx=True)
-add_insn("vpunpcklqdq", "xmm_xmm128_256avx2", modifiers=[0x66, 0x6C, VEXL0], avx=True)
+add_insn("vpmuludq", "xmm_xmm128_256avx2_q", modifiers=[0x66, 0xF4, VEXL0], avx=True)
+add_insn("vpshufd", "xmm_xmm128_imm_256avx2_d", modifiers=[0x66, 0x70, VEXL0], avx=True)
+add_insn("vpshufhw", "xmm_xmm128_imm_256avx2_bw", modifiers=[0xF3, 0x70, VEXL0], avx=True)
+add_insn("vpshuflw", "xmm_xmm128_imm_256avx2_bw", modifiers=[0xF2, 0x70, VEXL0], avx=True)
+add_insn("vpunpckhqdq", "xmm_xmm128_256avx2_q", modifiers=[0x66, 0x6D, VEXL0], avx=True)
+add_insn("vpunpcklqdq", "xmm_xmm128_256avx2_q", modifiers=[0x66, 0x6C, VEXL0], avx=True)
 
 add_insn("cvtss2sd", "xmm_xmm32", modifiers=[0xF3, 0x5A], cpu=["SSE2"])
-add_insn("vcvtss2sd", "xmm_xmm32", modifiers=[0xF3, 0x5A, VEXL0], avx=True)
+add_insn("vcvtss2sd", "xmm_xmm32_sae", modifiers=[0xF3, 0x5A, VEXL0], avx=True)
 
 add_group("maskmovdqu",
     cpu=["SSE2"],
@@ -5577,8 +5612,8 @@ add_group("pslrldq",
 
 add_insn("pslldq", "pslrldq", modifiers=[7])
 add_insn("psrldq", "pslrldq", modifiers=[3])
-add_insn("vpslldq", "pslrldq", modifiers=[7, VEXL0], avx=True)
-add_insn("vpsrldq", "pslrldq", modifiers=[3, VEXL0], avx=True)
+add_insn("vpslldq", "pslrldq_bw", modifiers=[7, VEXL0], avx=True)
+add_insn("vpsrldq", "pslrldq_bw", modifiers=[3, VEXL0], avx=True)
 
 #####################################################################
 # SSE3 / PNI Prescott New Instructions instructions
@@ -5684,18 +5719,18 @@ add_insn("pabsb",     "ssse3", modifiers=[0x1C])
 add_insn("pabsw",     "ssse3", modifiers=[0x1D])
 add_insn("pabsd",     "ssse3", modifiers=[0x1E])
 
-add_insn("vpshufb",    "ssse3", modifiers=[0x00, VEXL0], avx=True)
+add_insn("vpshufb",    "ssse3_bw", modifiers=[0x00, VEXL0], avx=True)
 add_insn("vphaddw",    "ssse3", modifiers=[0x01, VEXL0], avx=True)
 add_insn("vphaddd",    "ssse3", modifiers=[0x02, VEXL0], avx=True)
 add_insn("vphaddsw",   "ssse3", modifiers=[0x03, VEXL0], avx=True)
-add_insn("vpmaddubsw", "ssse3", modifiers=[0x04, VEXL0], avx=True)
+add_insn("vpmaddubsw", "ssse3_bw", modifiers=[0x04, VEXL0], avx=True)
 add_insn("vphsubw",    "ssse3", modifiers=[0x05, VEXL0], avx=True)
 add_insn("vphsubd",    "ssse3", modifiers=[0x06, VEXL0], avx=True)
 add_insn("vphsubsw",   "ssse3", modifiers=[0x07, VEXL0], avx=True)
 add_insn("vpsignb",    "ssse3", modifiers=[0x08, VEXL0], avx=True)
 add_insn("vpsignw",    "ssse3", modifiers=[0x09, VEXL0], avx=True)
 add_insn("vpsignd",    "ssse3", modifiers=[0x0A, VEXL0], avx=True)
-add_insn("vpmulhrsw",  "ssse3", modifiers=[0x0B, VEXL0], avx=True)
+add_insn("vpmulhrsw",  "ssse3_bw", modifiers=[0x0B, VEXL0], avx=True)
 # vpabsb/vpabsw/vpabsd are 2 operand only
 
 add_group("ssse3imm",
@@ -5715,7 +5750,7 @@ add_group("ssse3imm",
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
 add_insn("palignr", "ssse3imm", modifiers=[0x0F])
-add_insn("vpalignr", "sse4imm_256avx2", modifiers=[0x0F, VEXL0], avx=True)
+add_insn("vpalignr", "sse4imm_256avx2_bw", modifiers=[0x0F, VEXL0], avx=True)
 
 #####################################################################
 # SSE4.1 / SSE4.2 instructions
@@ -5755,19 +5790,19 @@ add_insn("ptest",      "sse4", modifiers=[0x17])
 
 # AVX versions use ssse3, and disable MMX version, as they're 3-operand
 add_insn("vpackusdw",   "ssse3", modifiers=[0x2B, VEXL0], avx=True)
-add_insn("vpcmpeqq",    "ssse3", modifiers=[0x29, VEXL0], avx=True)
-add_insn("vpcmpgtq",    "ssse3", modifiers=[0x37, VEXL0], avx=True)
+add_insn("vpcmpeqq",    "ssse3_k", modifiers=[0x29, VEXL0], avx=True)
+add_insn("vpcmpgtq",    "ssse3_k", modifiers=[0x37, VEXL0], avx=True)
 # vphminposuw is 2 operand only
-add_insn("vpmaxsb",     "ssse3", modifiers=[0x3C, VEXL0], avx=True)
-add_insn("vpmaxsd",     "ssse3", modifiers=[0x3D, VEXL0], avx=True)
-add_insn("vpmaxud",     "ssse3", modifiers=[0x3F, VEXL0], avx=True)
-add_insn("vpmaxuw",     "ssse3", modifiers=[0x3E, VEXL0], avx=True)
-add_insn("vpminsb",     "ssse3", modifiers=[0x38, VEXL0], avx=True)
-add_insn("vpminsd",     "ssse3", modifiers=[0x39, VEXL0], avx=True)
-add_insn("vpminud",     "ssse3", modifiers=[0x3B, VEXL0], avx=True)
-add_insn("vpminuw",     "ssse3", modifiers=[0x3A, VEXL0], avx=True)
-add_insn("vpmuldq",     "ssse3", modifiers=[0x28, VEXL0], avx=True)
-add_insn("vpmulld",     "ssse3", modifiers=[0x40, VEXL0], avx=True)
+add_insn("vpmaxsb",     "ssse3_bw", modifiers=[0x3C, VEXL0], avx=True)
+add_insn("vpmaxsd",     "ssse3_d", modifiers=[0x3D, VEXL0], avx=True)
+add_insn("vpmaxud",     "ssse3_d", modifiers=[0x3F, VEXL0], avx=True)
+add_insn("vpmaxuw",     "ssse3_bw", modifiers=[0x3E, VEXL0], avx=True)
+add_insn("vpminsb",     "ssse3_bw", modifiers=[0x38, VEXL0], avx=True)
+add_insn("vpminsd",     "ssse3_d", modifiers=[0x39, VEXL0], avx=True)
+add_insn("vpminud",     "ssse3_d", modifiers=[0x3B, VEXL0], avx=True)
+add_insn("vpminuw",     "ssse3_bw", modifiers=[0x3A, VEXL0], avx=True)
+add_insn("vpmuldq",     "ssse3_q", modifiers=[0x28, VEXL0], avx=True)
+add_insn("vpmulld",     "ssse3_d", modifiers=[0x40, VEXL0], avx=True)
 # vptest uses SSE4 style (2 operand only), and takes 256-bit operands
 add_insn("vptest", "sse4", modifiers=[0x17, VEXL0], avx=True)
 
@@ -6038,7 +6073,7 @@ add_group("extractps",
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
 add_insn("extractps", "extractps")
-add_insn("vextractps", "extractps", modifiers=[VEXL0], avx=True)
+add_insn("vextractps", "extractps_f", modifiers=[VEXL0], avx=True)
 
 add_group("insertps",
     cpu=["SSE41"],
@@ -6076,7 +6111,7 @@ add_group("insertps",
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
 add_insn("insertps", "insertps")
-add_insn("vinsertps", "insertps", modifiers=[VEXL0], avx=True)
+add_insn("vinsertps", "insertps_f", modifiers=[VEXL0], avx=True)
 
 add_group("movntdqa",
     cpu=["SSE41"],
@@ -6142,7 +6177,7 @@ add_group("pextrb",
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
 add_insn("pextrb", "pextrb")
-add_insn("vpextrb", "pextrb", modifiers=[VEXL0], avx=True)
+add_insn("vpextrb", "pextrb_bw", modifiers=[VEXL0], avx=True)
 
 add_group("pextrd",
     cpu=["SSE41"],
@@ -6154,7 +6189,7 @@ add_group("pextrd",
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
 add_insn("pextrd", "pextrd")
-add_insn("vpextrd", "pextrd", modifiers=[VEXL0], avx=True)
+add_insn("vpextrd", "pextrd_dq", modifiers=[VEXL0], avx=True)
 
 add_group("pextrq",
     cpu=["SSE41"],
@@ -6167,7 +6202,7 @@ add_group("pextrq",
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
 add_insn("pextrq", "pextrq")
-add_insn("vpextrq", "pextrq", modifiers=[VEXL0], avx=True)
+add_insn("vpextrq", "pextrq_dq", modifiers=[VEXL0], avx=True)
 
 add_group("pinsrb",
     cpu=["SSE41"],
@@ -6205,7 +6240,7 @@ add_group("pinsrb",
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
 add_insn("pinsrb", "pinsrb")
-add_insn("vpinsrb", "pinsrb", modifiers=[VEXL0], avx=True)
+add_insn("vpinsrb", "pinsrb_bw", modifiers=[VEXL0], avx=True)
 
 add_group("pinsrd",
     cpu=["SSE41"],
@@ -6226,7 +6261,7 @@ add_group("pinsrd",
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
 add_insn("pinsrd", "pinsrd")
-add_insn("vpinsrd", "pinsrd", modifiers=[VEXL0], avx=True)
+add_insn("vpinsrd", "pinsrd_dq", modifiers=[VEXL0], avx=True)
 
 add_group("pinsrq",
     cpu=["SSE41"],
@@ -6249,7 +6284,7 @@ add_group("pinsrq",
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
 add_insn("pinsrq", "pinsrq")
-add_insn("vpinsrq", "pinsrq", modifiers=[VEXL0], avx=True)
+add_insn("vpinsrq", "pinsrq_dq", modifiers=[VEXL0], avx=True)
 
 for sz in [16, 32, 64]:
     add_group("sse4m%d" % sz,
@@ -6290,28 +6325,28 @@ add_insn("pmovzxbw", "sse4m64", modifiers=[0x30])
 add_insn("pmovzxwd", "sse4m64", modifiers=[0x33])
 add_insn("pmovzxdq", "sse4m64", modifiers=[0x35])
 
-add_insn("vpmovsxbw", "sse4m64", modifiers=[0x20, VEXL0], avx=True)
-add_insn("vpmovsxwd", "sse4m64", modifiers=[0x23, VEXL0], avx=True)
-add_insn("vpmovsxdq", "sse4m64", modifiers=[0x25, VEXL0], avx=True)
-add_insn("vpmovzxbw", "sse4m64", modifiers=[0x30, VEXL0], avx=True)
-add_insn("vpmovzxwd", "sse4m64", modifiers=[0x33, VEXL0], avx=True)
-add_insn("vpmovzxdq", "sse4m64", modifiers=[0x35, VEXL0], avx=True)
+add_insn("vpmovsxbw", "sse4m64_bw", modifiers=[0x20, VEXL0], avx=True)
+add_insn("vpmovsxwd", "sse4m64_bw", modifiers=[0x23, VEXL0], avx=True)
+add_insn("vpmovsxdq", "sse4m64_f", modifiers=[0x25, VEXL0], avx=True)
+add_insn("vpmovzxbw", "sse4m64_bw", modifiers=[0x30, VEXL0], avx=True)
+add_insn("vpmovzxwd", "sse4m64_bw", modifiers=[0x33, VEXL0], avx=True)
+add_insn("vpmovzxdq", "sse4m64_f", modifiers=[0x35, VEXL0], avx=True)
 
 add_insn("pmovsxbd", "sse4m32", modifiers=[0x21])
 add_insn("pmovsxwq", "sse4m32", modifiers=[0x24])
 add_insn("pmovzxbd", "sse4m32", modifiers=[0x31])
 add_insn("pmovzxwq", "sse4m32", modifiers=[0x34])
 
-add_insn("vpmovsxbd", "sse4m32", modifiers=[0x21, VEXL0], avx=True)
-add_insn("vpmovsxwq", "sse4m32", modifiers=[0x24, VEXL0], avx=True)
-add_insn("vpmovzxbd", "sse4m32", modifiers=[0x31, VEXL0], avx=True)
-add_insn("vpmovzxwq", "sse4m32", modifiers=[0x34, VEXL0], avx=True)
+add_insn("vpmovsxbd", "sse4m32_f", modifiers=[0x21, VEXL0], avx=True)
+add_insn("vpmovsxwq", "sse4m32_f", modifiers=[0x24, VEXL0], avx=True)
+add_insn("vpmovzxbd", "sse4m32_f", modifiers=[0x31, VEXL0], avx=True)
+add_insn("vpmovzxwq", "sse4m32_f", modifiers=[0x34, VEXL0], avx=True)
 
 add_insn("pmovsxbq", "sse4m16", modifiers=[0x22])
 add_insn("pmovzxbq", "sse4m16", modifiers=[0x32])
 
-add_insn("vpmovsxbq", "sse4m16", modifiers=[0x22, VEXL0], avx=True)
-add_insn("vpmovzxbq", "sse4m16", modifiers=[0x32, VEXL0], avx=True)
+add_insn("vpmovsxbq", "sse4m16_f", modifiers=[0x22, VEXL0], avx=True)
+add_insn("vpmovzxbq", "sse4m16_f", modifiers=[0x32, VEXL0], avx=True)
 
 for sfx, sz in zip("wlq", [16, 32, 64]):
     add_group("cnt",
@@ -6407,15 +6442,15 @@ add_group("avx_xmm_xmm128",
     operands=[Operand(type="SIMDReg", size=256, dest="Spare"),
               Operand(type="SIMDRM", size=256, relaxed=True, dest="EA")])
 
-add_insn("vmovshdup", "avx_xmm_xmm128", modifiers=[0xF3, 0x16])
-add_insn("vmovsldup", "avx_xmm_xmm128", modifiers=[0xF3, 0x12])
+add_insn("vmovshdup", "avx_xmm_xmm128_w0", modifiers=[0xF3, 0x16])
+add_insn("vmovsldup", "avx_xmm_xmm128_w0", modifiers=[0xF3, 0x12])
 add_insn("vrcpps",    "avx_xmm_xmm128", modifiers=[0, 0x53])
 add_insn("vrsqrtps",  "avx_xmm_xmm128", modifiers=[0, 0x52])
-add_insn("vsqrtps",   "avx_xmm_xmm128", modifiers=[0, 0x51])
-add_insn("vsqrtpd",   "avx_xmm_xmm128", modifiers=[0x66, 0x51])
-add_insn("vcvtdq2ps", "avx_xmm_xmm128", modifiers=[0, 0x5B])
-add_insn("vcvtps2dq", "avx_xmm_xmm128", modifiers=[0x66, 0x5B])
-add_insn("vcvttps2dq", "avx_xmm_xmm128", modifiers=[0xF3, 0x5B])
+add_insn("vsqrtps",   "avx_xmm_xmm128_ps_er", modifiers=[0, 0x51])
+add_insn("vsqrtpd",   "avx_xmm_xmm128_pd_er", modifiers=[0x66, 0x51])
+add_insn("vcvtdq2ps", "avx_xmm_xmm128_ps_er", modifiers=[0, 0x5B])
+add_insn("vcvtps2dq", "avx_xmm_xmm128_ps_er", modifiers=[0x66, 0x5B])
+add_insn("vcvttps2dq", "avx_xmm_xmm128_ps_sae", modifiers=[0xF3, 0x5B])
 
 add_group("avx_sse4imm",
     cpu=["SSE41"],
@@ -6545,8 +6580,8 @@ add_group("avx_cvt_xmm64",
     operands=[Operand(type="SIMDReg", size=256, dest="Spare"),
               Operand(type="SIMDRM", size=128, relaxed=True, dest="EA")])
 
-add_insn("vcvtdq2pd", "avx_cvt_xmm64", modifiers=[0xF3, 0xE6])
-add_insn("vcvtps2pd", "avx_cvt_xmm64", modifiers=[0, 0x5A])
+add_insn("vcvtdq2pd", "avx_cvt_xmm64_dq", modifiers=[0xF3, 0xE6])
+add_insn("vcvtps2pd", "avx_cvt_xmm64_ps", modifiers=[0, 0x5A])
 
 # Some SSE3 opcodes are only two operand in AVX
 # (VEX.vvvv must be 1111b)
@@ -6570,9 +6605,9 @@ for cpu, sz in zip(["AVX", "AVX2"], [128, 256]):
         opcode=[0x0F, 0x38, 0x00],
         operands=[Operand(type="SIMDReg", size=sz, dest="Spare"),
                   Operand(type="SIMDRM", size=sz, relaxed=True, dest="EA")])
-add_insn("vpabsb",     "avx2_ssse3_2op", modifiers=[0x1C], avx=True)
-add_insn("vpabsw",     "avx2_ssse3_2op", modifiers=[0x1D], avx=True)
-add_insn("vpabsd",     "avx2_ssse3_2op", modifiers=[0x1E], avx=True)
+add_insn("vpabsb",     "avx2_ssse3_2op_bw", modifiers=[0x1C], avx=True)
+add_insn("vpabsw",     "avx2_ssse3_2op_bw", modifiers=[0x1D], avx=True)
+add_insn("vpabsd",     "avx2_ssse3_2op_d", modifiers=[0x1E], avx=True)
 
 # Some conversion functions take xmm, ymm combination
 # Need separate x and y versions for gas mode
@@ -6612,15 +6647,15 @@ add_group("avx_cvt_xmm128",
 
 add_insn("vcvtpd2dqx", "avx_cvt_xmm128_x", modifiers=[0xF2, 0xE6], parser="gas")
 add_insn("vcvtpd2dqy", "avx_cvt_xmm128_y", modifiers=[0xF2, 0xE6], parser="gas")
-add_insn("vcvtpd2dq", "avx_cvt_xmm128", modifiers=[0xF2, 0xE6])
+add_insn("vcvtpd2dq", "avx_cvt_xmm128_er", modifiers=[0xF2, 0xE6])
 
 add_insn("vcvtpd2psx", "avx_cvt_xmm128_x", modifiers=[0x66, 0x5A], parser="gas")
 add_insn("vcvtpd2psy", "avx_cvt_xmm128_y", modifiers=[0x66, 0x5A], parser="gas")
-add_insn("vcvtpd2ps", "avx_cvt_xmm128", modifiers=[0x66, 0x5A])
+add_insn("vcvtpd2ps", "avx_cvt_xmm128_er", modifiers=[0x66, 0x5A])
 
 add_insn("vcvttpd2dqx", "avx_cvt_xmm128_x", modifiers=[0x66, 0xE6], parser="gas")
 add_insn("vcvttpd2dqy", "avx_cvt_xmm128_y", modifiers=[0x66, 0xE6], parser="gas")
-add_insn("vcvttpd2dq", "avx_cvt_xmm128", modifiers=[0x66, 0xE6])
+add_insn("vcvttpd2dq", "avx_cvt_xmm128_sae", modifiers=[0x66, 0xE6])
 
 # Instructions new to AVX
 add_insn("vtestps", "sse4", modifiers=[0x0E, VEXL0], avx=True)
@@ -6792,8 +6827,8 @@ add_group("vpermil",
               Operand(type="SIMDRM", size=256, relaxed=True, dest="EA"),
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
-add_insn("vpermilpd", "vpermil", modifiers=[0x05])
-add_insn("vpermilps", "vpermil", modifiers=[0x04])
+add_insn("vpermilpd", "vpermil_pd", modifiers=[0x05])
+add_insn("vpermilps", "vpermil_ps", modifiers=[0x04])
 
 add_group("vperm2f128",
     cpu=["AVX"],
@@ -6841,8 +6876,8 @@ add_group("vperm_imm_avx2",
               Operand(type="SIMDRM", size=256, relaxed=True, dest="EA"),
               Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
 
-add_insn("vpermq",     "vperm_imm_avx2", modifiers=[0x00])
-add_insn("vpermpd",    "vperm_imm_avx2", modifiers=[0x01])
+add_insn("vpermq",     "vperm_imm_avx2", modifiers=[0x00, 0x36])
+add_insn("vpermpd",    "vperm_imm_avx2", modifiers=[0x01, 0x16])
 
 add_group("vperm2i128_avx2",
     cpu=["AVX2"],
@@ -6875,7 +6910,7 @@ for sz in [128, 256]:
         prefix=0x66,
         opcode=[0x0F, 0x38, 0x78],
         operands=[Operand(type="SIMDReg", size=sz, dest="Spare"),
-                  Operand(type="RM", size=8, relaxed=True, dest="EA")])
+                  Operand(type="Mem", size=8, relaxed=True, dest="EA")])
 
 add_insn("vpbroadcastb", "vpbroadcastb_avx2")
 
@@ -6898,7 +6933,7 @@ for sz in [128, 256]:
         prefix=0x66,
         opcode=[0x0F, 0x38, 0x79],
         operands=[Operand(type="SIMDReg", size=sz, dest="Spare"),
-                  Operand(type="RM", size=16, relaxed=True, dest="EA")])
+                  Operand(type="Mem", size=16, relaxed=True, dest="EA")])
 
 add_insn("vpbroadcastw", "vpbroadcastw_avx2")
 
@@ -6921,7 +6956,7 @@ for sz in [128, 256]:
         prefix=0x66,
         opcode=[0x0F, 0x38, 0x58],
         operands=[Operand(type="SIMDReg", size=sz, dest="Spare"),
-                  Operand(type="RM", size=32, relaxed=True, dest="EA")])
+                  Operand(type="Mem", size=32, relaxed=True, dest="EA")])
 
 add_insn("vpbroadcastd", "vpbroadcastd_avx2")
 
@@ -7281,6 +7316,15 @@ add_group("aes",
     operands=[Operand(type="SIMDReg", size=128, dest="Spare"),
               Operand(type="SIMDReg", size=128, dest="VEX"),
               Operand(type="SIMDRM", size=128, relaxed=True, dest="EA")])
+add_group("aes",
+    cpu=["VAES", "AVX"],
+    modifiers=["Op1Add", "Op2Add"],
+    vex=256,
+    prefix=0x66,
+    opcode=[0x0F, 0x00, 0x00],
+    operands=[Operand(type="SIMDReg", size=256, dest="Spare"),
+              Operand(type="SIMDReg", size=256, dest="VEX"),
+              Operand(type="SIMDRM", size=256, relaxed=True, dest="EA")])
 
 
 add_insn("aesenc", "aes", modifiers=[0x38, 0xDC])
@@ -7340,6 +7384,16 @@ add_group("pclmulqdq",
               Operand(type="SIMDReg", size=128,               dest="VEX"),
               Operand(type="SIMDRM",  size=128, relaxed=True, dest="EA"),
               Operand(type="Imm",     size=8,   relaxed=True, dest="Imm")])
+add_group("pclmulqdq",
+    cpu=["VPCLMULQDQ", "AVX"],
+    modifiers=["Op1Add", "Op2Add"],
+    vex=256,
+    prefix=0x66,
+    opcode=[0x0F, 0x00, 0x00],
+    operands=[Operand(type="SIMDReg", size=256,               dest="Spare"),
+              Operand(type="SIMDReg", size=256,               dest="VEX"),
+              Operand(type="SIMDRM",  size=256, relaxed=True, dest="EA"),
+              Operand(type="Imm",     size=8,   relaxed=True, dest="Imm")])
 
 add_insn("pclmulqdq", "pclmulqdq", modifiers=[0x3A, 0x44])
 add_insn("vpclmulqdq", "pclmulqdq", modifiers=[0x3A, 0x44, VEXL0], avx=True)
@@ -7360,12 +7414,96 @@ add_group("pclmulqdq_fixed",
     operands=[Operand(type="SIMDReg", size=128, dest="Spare"),
               Operand(type="SIMDReg", size=128, dest="VEX"),
               Operand(type="SIMDRM",  size=128, relaxed=True, dest="EA")])
+add_group("pclmulqdq_fixed",
+    cpu=["VPCLMULQDQ", "AVX"],
+    modifiers=["Imm8"],
+    vex=256,
+    prefix=0x66,
+    opcode=[0x0F, 0x3A, 0x44],
+    operands=[Operand(type="SIMDReg", size=256, dest="Spare"),
+              Operand(type="SIMDReg", size=256, dest="VEX"),
+              Operand(type="SIMDRM",  size=256, relaxed=True, dest="EA")])
 
 for comb, combval in zip(["lql","hql","lqh","hqh"], [0x00,0x01,0x10,0x11]):
     add_insn("pclmul"+comb+"qdq", "pclmulqdq_fixed", modifiers=[combval])
     add_insn("vpclmul"+comb+"qdq", "pclmulqdq_fixed",
              modifiers=[combval, VEXL0], avx=True)
 
+#####################################################################
+# Intel GFNI instructions
+#####################################################################
+
+add_group("gfni",
+    cpu=["GFNI"],
+    modifiers=["Op2Add", "SetVEX"],
+    prefix=0x66,
+    opcode=[0x0F, 0x38, 0x00],
+    operands=[Operand(type="SIMDReg", size=128, dest="SpareVEX"),
+              Operand(type="SIMDRM", size=128, relaxed=True, dest="EA")])
+add_group("gfni_imm",
+    cpu=["GFNI"],
+    modifiers=["Op2Add", "SetVEX"],
+    prefix=0x66,
+    opcode=[0x0F, 0x3A, 0x00],
+    operands=[Operand(type="SIMDReg", size=128, dest="SpareVEX"),
+              Operand(type="SIMDRM", size=128, relaxed=True, dest="EA"),
+              Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
+for sz in [128, 256]:
+    add_group("gfni",
+        cpu=["GFNI", "AVX"],
+        modifiers=["Op2Add"],
+        vex=sz,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=[Operand(type="SIMDReg", size=sz, dest="Spare"),
+                  Operand(type="SIMDReg", size=sz, dest="VEX"),
+                  Operand(type="SIMDRM", size=sz, relaxed=True, dest="EA")])
+    add_group("gfni_imm",
+        cpu=["GFNI", "AVX"],
+        modifiers=["Op2Add"],
+        vex=sz,
+        vexw=1,
+        prefix=0x66,
+        opcode=[0x0F, 0x3A, 0x00],
+        operands=[Operand(type="SIMDReg", size=sz, dest="Spare"),
+                  Operand(type="SIMDReg", size=sz, dest="VEX"),
+                  Operand(type="SIMDRM", size=sz, relaxed=True, dest="EA"),
+                  Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
+
+add_insn("gf2p8mulb", "gfni", modifiers=[0xCF])
+add_insn("gf2p8affineqb", "gfni_imm", modifiers=[0xCE])
+add_insn("gf2p8affineinvqb", "gfni_imm", modifiers=[0xCF])
+
+add_insn("vgf2p8mulb", "gfni", modifiers=[0xCF, VEXL0], avx=True)
+add_insn("vgf2p8affineqb", "gfni_imm", modifiers=[0xCE, VEXW1], avx=True)
+add_insn("vgf2p8affineinvqb", "gfni_imm", modifiers=[0xCF, VEXW1], avx=True)
+
+#####################################################################
+# Intel AVX-VNNI and AVX-IFMA instructions
+#####################################################################
+
+for cpu, w in [("AVXVNNI", 0), ("AVXIFMA", 1)]:
+    for sz in [128, 256]:
+        add_group(cpu.lower(),
+            cpu=[cpu],
+            modifiers=["Op2Add"],
+            vex=sz,
+            vexw=w,
+            prefix=0x66,
+            opcode=[0x0F, 0x38, 0x00],
+            operands=[Operand(type="SIMDReg", size=sz, dest="Spare"),
+                      Operand(type="SIMDReg", size=sz, dest="VEX"),
+                      Operand(type="SIMDRM", size=sz, relaxed=True,
+                              dest="EA")])
+
+add_insn("vpdpbusd", "avxvnni", modifiers=[0x50])
+add_insn("vpdpbusds", "avxvnni", modifiers=[0x51])
+add_insn("vpdpwssd", "avxvnni", modifiers=[0x52])
+add_insn("vpdpwssds", "avxvnni", modifiers=[0x53])
+
+add_insn("vpmadd52luq", "avxifma", modifiers=[0xB4])
+add_insn("vpmadd52huq", "avxifma", modifiers=[0xB5])
+
 #####################################################################
 # AVX Post-32nm instructions
 #####################################################################
@@ -7926,6 +8064,23 @@ for sfx, sz in zip("wlq", [16, 32, 64]):
                   Operand(type="Reg", size=sz, dest="Spare")])
 add_insn("movbe", "movbe")
 
+#####################################################################
+# Intel MOVDIRI and SERIALIZE instructions
+#####################################################################
+
+for sfx, sz in zip("lq", [32, 64]):
+    add_group("movdiri",
+        cpu=["MOVDIRI"],
+        suffix=sfx,
+        opersize=sz,
+        opcode=[0x0F, 0x38, 0xF9],
+        operands=[Operand(type="Mem", size=sz, relaxed=True, dest="EA"),
+                  Operand(type="Reg", size=sz, dest="Spare")])
+add_insn("movdiri", "movdiri")
+
+add_insn("serialize", "threebyte", modifiers=[0x0F, 0x01, 0xE8],
+         cpu=["SERIALIZE"])
+
 #####################################################################
 # Intel advanced bit manipulations (BMI1/2)
 #####################################################################
@@ -8456,6 +8611,1392 @@ add_group("xbts",
 
 add_insn("xbts", "xbts")
 
+#####################################################################
+# Intel AVX-512 instructions
+#####################################################################
+# EVEX forms of existing instructions are added to copies of their SSE/AVX
+# groups, after the VEX forms, so the shorter VEX encoding is still chosen
+# whenever no AVX-512 register or decorator requires EVEX.
+# The 128 and 256-bit forms need AVX512VL in addition to the base feature;
+# embedded rounding/SAE is only available on the 512-bit register form.
+
+def add_evex_group(name, cpu, evex_flags=[], rounding=None,
+                   sizes=[128, 256, 512], **kwargs):
+    operands = kwargs.pop("operands")
+    for sz in sizes:
+        flags = list(evex_flags)
+        form_cpu = list(cpu)
+        if sz != 512:
+            form_cpu.append("AVX512VL")
+        elif rounding is not None:
+            flags.append(rounding)
+        add_group(name, cpu=form_cpu, evex=sz, evex_flags=flags,
+                  operands=operands(sz), **kwargs)
+
+def copy_group(name, base):
+    for form in groups[base]:
+        groups.setdefault(name, []).append(form)
+    groupnames_ordered.append(name)
+
+# Drop a group once every instruction uses one of its copies, so it isn't
+# output unused.
+def retire_group(name):
+    del groups[name]
+    groupnames_ordered[:] = [x for x in groupnames_ordered if x != name]
+
+def evex_xmm_xmm_xmm(sz):
+    return [Operand(type="EVEXReg", size=sz, dest="Spare"),
+            Operand(type="EVEXReg", size=sz, dest="VEX"),
+            Operand(type="EVEXRM", size=sz, relaxed=True, dest="EA")]
+
+def evex_xmm_xmm(sz):
+    return [Operand(type="EVEXReg", size=sz, dest="Spare"),
+            Operand(type="EVEXRM", size=sz, relaxed=True, dest="EA")]
+
+def evex_xmm_xmm_imm(sz):
+    return evex_xmm_xmm(sz) + [Operand(type="Imm", size=8, relaxed=True,
+                                       dest="Imm")]
+
+def evex_k_xmm_xmm(sz):
+    return [Operand(type="KReg", size=64, dest="Spare"),
+            Operand(type="EVEXReg", size=sz, dest="VEX"),
+            Operand(type="EVEXRM", size=sz, relaxed=True, dest="EA")]
+
+def evex_k_xmm_xmm_imm(sz):
+    return evex_k_xmm_xmm(sz) + [Operand(type="Imm", size=8, relaxed=True,
+                                         dest="Imm")]
+
+def evex_xmm_xmm_xmm_imm(sz):
+    return evex_xmm_xmm_xmm(sz) + [Operand(type="Imm", size=8, relaxed=True,
+                                           dest="Imm")]
+
+# Element width (EVEX.W) and broadcast element size
+evex_w = {"d": (0, "B32"), "q": (1, "B64"), "ps": (0, "B32"),
+          "pd": (1, "B64")}
+
+#
+# Packed floating point arithmetic
+#
+for base, mods, opcode, prefix, operands in [
+        ("xmm_xmm128_256", ["PreAdd", "Op1Add"], [0x0F, 0x00], 0x00,
+         evex_xmm_xmm_xmm),
+        ("avx_xmm_xmm128", ["PreAdd", "Op1Add"], [0x0F, 0x00], 0x00,
+         evex_xmm_xmm)]:
+    for elem in ["ps", "pd"]:
+        w, bcst = evex_w[elem]
+        for cpu, rounding in [("AVX512F", "ER"), ("AVX512F", "SAE"),
+                              ("AVX512DQ", None), ("AVX512F", None)]:
+            if base == "avx_xmm_xmm128" and rounding != "ER" and \
+               (elem, rounding) != ("ps", "SAE"):
+                continue
+            name = "%s_%s_%s" % (base, elem,
+                                 (rounding or cpu[6:]).lower())
+            copy_group(name, base)
+            add_evex_group(name,
+                cpu=[cpu],
+                evex_flags=["MASK", "ZERO", bcst],
+                rounding=rounding,
+                modifiers=mods,
+                evexw=w,
+                prefix=prefix,
+                opcode=opcode,
+                operands=operands)
+
+#
+# Scalar floating point arithmetic
+#
+for base, w, memsz in [("xmm_xmm32", 0, 32), ("xmm_xmm64", 1, 64)]:
+    for rounding in ["ER", "SAE"]:
+        name = "%s_%s" % (base, rounding.lower())
+        copy_group(name, base)
+        add_group(name,
+            cpu=["AVX512F"],
+            evex_flags=["MASK", "ZERO", rounding],
+            modifiers=["PreAdd", "Op1Add"],
+            evex=128,
+            evexw=w,
+            prefix=0x00,
+            opcode=[0x0F, 0x00],
+            operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+                      Operand(type="EVEXReg", size=128, dest="VEX"),
+                      Operand(type="EVEXReg", size=128, dest="EA")])
+        add_group(name,
+            cpu=["AVX512F"],
+            evex_flags=["MASK", "ZERO"],
+            modifiers=["PreAdd", "Op1Add"],
+            evex=128,
+            evexw=w,
+            prefix=0x00,
+            opcode=[0x0F, 0x00],
+            operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+                      Operand(type="EVEXReg", size=128, dest="VEX"),
+                      Operand(type="Mem", size=memsz, relaxed=True,
+                              dest="EA")])
+
+# Integer to scalar conversions; the 64-bit source (and the 32-bit one for
+# single precision) may not be exact, so takes a rounding mode.
+for name, rnd32 in [("cvt_xmm_rmx_ss", ["ER"]), ("cvt_xmm_rmx_sd", [])]:
+    copy_group(name, "cvt_xmm_rmx")
+    for suffix, opersize, regsz, rounding in [("l", 0, 32, rnd32),
+                                              ("q", 64, 64, ["ER"])]:
+        add_group(name,
+            suffix=suffix,
+            cpu=["AVX512F"],
+            evex_flags=rounding,
+            modifiers=["PreAdd", "Op1Add"],
+            evex=128,
+            opersize=opersize,
+            prefix=0x00,
+            opcode=[0x0F, 0x00],
+            operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+                      Operand(type="EVEXReg", size=128, dest="VEX"),
+                      Operand(type="RM", size=regsz, dest="EA")])
+
+#
+# Packed integer arithmetic and logic
+#
+# 0F38 map: (group, cpu, EVEX.W, broadcast); the avx512 groups have no
+# SSE or VEX forms.
+for name in ["ssse3_d", "ssse3_q", "ssse3_bw"]:
+    copy_group(name, "ssse3")
+for name, cpu, w, bcst in [("ssse3_d", "AVX512F", 0, ["B32"]),
+                           ("ssse3_q", "AVX512F", 1, ["B64"]),
+                           ("ssse3_bw", "AVX512BW", 0, []),
+                           ("avx512_ssse3_d", "AVX512F", 0, ["B32"]),
+                           ("avx512_ssse3_q", "AVX512F", 1, ["B64"]),
+                           ("avx512dq_ssse3_q", "AVX512DQ", 1, ["B64"]),
+                           ("avx512bw_ssse3_w0", "AVX512BW", 0, []),
+                           ("avx512bw_ssse3_w1", "AVX512BW", 1, [])]:
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"] + bcst,
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=evex_xmm_xmm_xmm)
+
+for elem in ["d", "q"]:
+    w, bcst = evex_w[elem]
+    copy_group("xmm_xmm128_256avx2_"+elem, "xmm_xmm128_256avx2")
+    for name in ["xmm_xmm128_256avx2_"+elem, "avx512_"+elem]:
+        add_evex_group(name,
+            cpu=["AVX512F"],
+            evex_flags=["MASK", "ZERO", bcst],
+            modifiers=["PreAdd", "Op1Add"],
+            evexw=w,
+            prefix=0x00,
+            opcode=[0x0F, 0x00],
+            operands=evex_xmm_xmm_xmm)
+    add_evex_group("avx512_cd_"+elem,
+        cpu=["AVX512CD"],
+        evex_flags=["MASK", "ZERO", bcst],
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=evex_xmm_xmm)
+    add_evex_group("avx512_ternlog_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", bcst],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x3A, 0x25],
+        operands=evex_xmm_xmm_xmm_imm)
+
+copy_group("xmm_xmm128_256avx2_bw", "xmm_xmm128_256avx2")
+add_evex_group("xmm_xmm128_256avx2_bw",
+    cpu=["AVX512BW"],
+    evex_flags=["MASK", "ZERO"],
+    modifiers=["PreAdd", "Op1Add"],
+    prefix=0x00,
+    opcode=[0x0F, 0x00],
+    operands=evex_xmm_xmm_xmm)
+
+for name, op in [("and", 0xDB), ("andn", 0xDF), ("or", 0xEB),
+                 ("xor", 0xEF)]:
+    add_insn("vp%sd" % name, "avx512_d", modifiers=[0x66, op])
+    add_insn("vp%sq" % name, "avx512_q", modifiers=[0x66, op])
+
+add_insn("vpmullq", "avx512dq_ssse3_q", modifiers=[0x40])
+add_insn("vpminsq", "avx512_ssse3_q", modifiers=[0x39])
+add_insn("vpminuq", "avx512_ssse3_q", modifiers=[0x3B])
+add_insn("vpmaxsq", "avx512_ssse3_q", modifiers=[0x3D])
+add_insn("vpmaxuq", "avx512_ssse3_q", modifiers=[0x3F])
+add_insn("vprorvd", "avx512_ssse3_d", modifiers=[0x14])
+add_insn("vprorvq", "avx512_ssse3_q", modifiers=[0x14])
+add_insn("vprolvd", "avx512_ssse3_d", modifiers=[0x15])
+add_insn("vprolvq", "avx512_ssse3_q", modifiers=[0x15])
+add_insn("vpblendmb", "avx512bw_ssse3_w0", modifiers=[0x66])
+add_insn("vpblendmw", "avx512bw_ssse3_w1", modifiers=[0x66])
+add_insn("vpblendmd", "avx512_ssse3_d", modifiers=[0x64])
+add_insn("vpblendmq", "avx512_ssse3_q", modifiers=[0x64])
+add_insn("vblendmps", "avx512_ssse3_d", modifiers=[0x65])
+add_insn("vblendmpd", "avx512_ssse3_q", modifiers=[0x65])
+add_insn("vplzcntd", "avx512_cd_d", modifiers=[0x44])
+add_insn("vplzcntq", "avx512_cd_q", modifiers=[0x44])
+add_insn("vpconflictd", "avx512_cd_d", modifiers=[0xC4])
+add_insn("vpconflictq", "avx512_cd_q", modifiers=[0xC4])
+add_insn("vpternlogd", "avx512_ternlog_d")
+add_insn("vpternlogq", "avx512_ternlog_q")
+
+# Absolute value; vpabsq has no VEX form.
+for name, cpu, w, bcst in [("avx2_ssse3_2op_bw", "AVX512BW", 0, []),
+                           ("avx2_ssse3_2op_d", "AVX512F", 0, ["B32"]),
+                           ("avx512_ssse3_2op_d", "AVX512F", 0, ["B32"]),
+                           ("avx512_ssse3_2op_q", "AVX512F", 1, ["B64"])]:
+    if name.startswith("avx2"):
+        copy_group(name, "avx2_ssse3_2op")
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"] + bcst,
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=evex_xmm_xmm)
+retire_group("avx2_ssse3_2op")
+
+add_insn("vpabsq", "avx512_ssse3_2op_q", modifiers=[0x1F])
+
+# Rotates by an immediate count
+for elem in ["d", "q"]:
+    w, bcst = evex_w[elem]
+    add_evex_group("avx512_vprot_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", bcst],
+        modifiers=["SpAdd"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x72],
+        spare=0,
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="VEX"),
+                             Operand(type="EVEXRM", size=sz, relaxed=True,
+                                     dest="EA"),
+                             Operand(type="Imm", size=8, relaxed=True,
+                                     dest="Imm")])
+    add_insn("vpror"+elem, "avx512_vprot_"+elem, modifiers=[0])
+    add_insn("vprol"+elem, "avx512_vprot_"+elem, modifiers=[1])
+
+#
+# Comparisons into opmask registers
+#
+copy_group("xmm_xmm128_256avx2_kbw", "xmm_xmm128_256avx2")
+add_evex_group("xmm_xmm128_256avx2_kbw",
+    cpu=["AVX512BW"],
+    evex_flags=["MASK"],
+    modifiers=["PreAdd", "Op1Add"],
+    prefix=0x00,
+    opcode=[0x0F, 0x00],
+    operands=evex_k_xmm_xmm)
+
+for elem in ["d", "q"]:
+    w, bcst = evex_w[elem]
+    base = ("xmm_xmm128_256avx2" if elem == "d" else "ssse3")
+    name = base + "_k"
+    copy_group(name, base)
+    add_evex_group(name,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", bcst],
+        modifiers=(["PreAdd", "Op1Add"] if elem == "d" else ["Op2Add"]),
+        evexw=w,
+        prefix=(0x00 if elem == "d" else 0x66),
+        opcode=([0x0F, 0x00] if elem == "d" else [0x0F, 0x38, 0x00]),
+        operands=evex_k_xmm_xmm)
+
+for elem in ["ps", "pd"]:
+    w, bcst = evex_w[elem]
+    copy_group("xmm_xmm128_imm_256_k"+elem, "xmm_xmm128_imm_256")
+    add_evex_group("xmm_xmm128_imm_256_k"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", bcst],
+        rounding="SAE",
+        modifiers=["PreAdd", "Op1Add"],
+        evexw=w,
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=evex_k_xmm_xmm_imm)
+
+# Element widths of the integer instructions new to AVX-512:
+# (cpu, EVEX.W, broadcast)
+evex_int = {"b": ("AVX512BW", 0, []), "w": ("AVX512BW", 1, []),
+            "d": ("AVX512F", 0, ["B32"]), "q": ("AVX512F", 1, ["B64"])}
+
+for elem in "bwdq":
+    cpu, w, bcst = evex_int[elem]
+    # Compares with an immediate predicate
+    add_evex_group("avx512_cmp_"+elem,
+        cpu=[cpu],
+        evex_flags=["MASK"] + bcst,
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x3A, 0x00],
+        operands=evex_k_xmm_xmm_imm)
+    # Bitwise tests
+    add_evex_group("avx512_test_"+elem,
+        cpu=[cpu],
+        evex_flags=["MASK"] + bcst,
+        modifiers=["PreAdd", "Op2Add"],
+        evexw=w,
+        prefix=0x00,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=evex_k_xmm_xmm)
+    op = (elem in "bw") and 0x3E or 0x1E
+    add_insn("vpcmp"+elem, "avx512_cmp_"+elem, modifiers=[op+1])
+    add_insn("vpcmpu"+elem, "avx512_cmp_"+elem, modifiers=[op])
+    op = (elem in "bw") and 0x26 or 0x27
+    add_insn("vptestm"+elem, "avx512_test_"+elem, modifiers=[0x66, op])
+    add_insn("vptestnm"+elem, "avx512_test_"+elem, modifiers=[0xF3, op])
+
+#
+# Moves
+#
+for elem in ["ps", "pd"]:
+    w, bcst = evex_w[elem]
+    copy_group("movau_"+elem, "movau")
+    add_evex_group("movau_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO"],
+        modifiers=["PreAdd", "Op1Add"],
+        evexw=w,
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=evex_xmm_xmm)
+    add_evex_group("movau_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK"],
+        modifiers=["PreAdd", "Op1Add", "Op1Add"],
+        evexw=w,
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=lambda sz: [Operand(type="EVEXRM", size=sz, relaxed=True,
+                                     dest="EA"),
+                             Operand(type="EVEXReg", size=sz, dest="Spare")])
+
+for cpu, w in [("AVX512F", 0), ("AVX512F", 1), ("AVX512BW", 0),
+               ("AVX512BW", 1)]:
+    name = "avx512_movdq_%s_w%d" % (cpu[6:].lower(), w)
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"],
+        modifiers=["PreAdd", "Op1Add"],
+        evexw=w,
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=evex_xmm_xmm)
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK"],
+        modifiers=["PreAdd", "Op1Add", "Op1Add"],
+        evexw=w,
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=lambda sz: [Operand(type="EVEXRM", size=sz, relaxed=True,
+                                     dest="EA"),
+                             Operand(type="EVEXReg", size=sz, dest="Spare")])
+
+for name, prefix, w, memsz in [("movss", 0xF3, 0, 32), ("movsd", 0xF2, 1, 64)]:
+    add_group(name,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO"],
+        evex=128,
+        evexw=w,
+        prefix=prefix,
+        opcode=[0x0F, 0x10],
+        operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+                  Operand(type="EVEXReg", size=128, dest="VEX"),
+                  Operand(type="EVEXReg", size=128, dest="EA")])
+    add_group(name,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO"],
+        evex=128,
+        evexw=w,
+        prefix=prefix,
+        opcode=[0x0F, 0x10],
+        operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+                  Operand(type="Mem", size=memsz, relaxed=True, dest="EA")])
+    add_group(name,
+        cpu=["AVX512F"],
+        evex_flags=["MASK"],
+        evex=128,
+        evexw=w,
+        prefix=prefix,
+        opcode=[0x0F, 0x11],
+        operands=[Operand(type="Mem", size=memsz, relaxed=True, dest="EA"),
+                  Operand(type="EVEXReg", size=128, dest="Spare")])
+
+# Duplicating moves; the 128-bit vmovddup reads only 64 bits.
+copy_group("avx_xmm_xmm128_w0", "avx_xmm_xmm128")
+add_evex_group("avx_xmm_xmm128_w0",
+    cpu=["AVX512F"],
+    evex_flags=["MASK", "ZERO"],
+    modifiers=["PreAdd", "Op1Add"],
+    prefix=0x00,
+    opcode=[0x0F, 0x00],
+    operands=evex_xmm_xmm)
+
+add_group("vmovddup",
+    cpu=["AVX512F", "AVX512VL"],
+    evex_flags=["MASK", "ZERO"],
+    modifiers=["PreAdd", "Op1Add"],
+    evex=128,
+    evexw=1,
+    prefix=0x00,
+    opcode=[0x0F, 0x00],
+    operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+              Operand(type="EVEXReg", size=128, dest="EA")])
+add_group("vmovddup",
+    cpu=["AVX512F", "AVX512VL"],
+    evex_flags=["MASK", "ZERO"],
+    modifiers=["PreAdd", "Op1Add"],
+    evex=128,
+    evexw=1,
+    prefix=0x00,
+    opcode=[0x0F, 0x00],
+    operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+              Operand(type="Mem", size=64, relaxed=True, dest="EA")])
+add_evex_group("vmovddup",
+    cpu=["AVX512F"],
+    evex_flags=["MASK", "ZERO"],
+    sizes=[256, 512],
+    modifiers=["PreAdd", "Op1Add"],
+    evexw=1,
+    prefix=0x00,
+    opcode=[0x0F, 0x00],
+    operands=evex_xmm_xmm)
+
+add_insn("vmovdqa32", "avx512_movdq_f_w0", modifiers=[0x66, 0x6F, 0x10])
+add_insn("vmovdqa64", "avx512_movdq_f_w1", modifiers=[0x66, 0x6F, 0x10])
+add_insn("vmovdqu32", "avx512_movdq_f_w0", modifiers=[0xF3, 0x6F, 0x10])
+add_insn("vmovdqu64", "avx512_movdq_f_w1", modifiers=[0xF3, 0x6F, 0x10])
+add_insn("vmovdqu8", "avx512_movdq_bw_w0", modifiers=[0xF2, 0x6F, 0x10])
+add_insn("vmovdqu16", "avx512_movdq_bw_w1", modifiers=[0xF2, 0x6F, 0x10])
+
+# Sign and zero extension: (group, cpu, source/destination size ratio)
+for name, cpu, ratio in [("sse4m64_bw", "AVX512BW", 2),
+                         ("sse4m64_f", "AVX512F", 2),
+                         ("sse4m32_f", "AVX512F", 4),
+                         ("sse4m16_f", "AVX512F", 8)]:
+    copy_group(name, name.split("_")[0])
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"],
+        modifiers=["Op2Add"],
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="Spare"),
+                             Operand(type="EVEXReg", size=max(sz//ratio, 128),
+                                     dest="EA")])
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"],
+        modifiers=["Op2Add"],
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="Spare"),
+                             Operand(type="Mem", size=sz//ratio, relaxed=True,
+                                     dest="EA")])
+
+# Truncation, plain or with signed or unsigned saturation:
+# (group, cpu, destination/source size ratio)
+for name, cpu, ratio in [("avx512_pmov2_bw", "AVX512BW", 2),
+                         ("avx512_pmov2", "AVX512F", 2),
+                         ("avx512_pmov4", "AVX512F", 4),
+                         ("avx512_pmov8", "AVX512F", 8)]:
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"],
+        modifiers=["Op2Add"],
+        prefix=0xF3,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=max(sz//ratio, 128),
+                                     dest="EA"),
+                             Operand(type="EVEXReg", size=sz, dest="Spare")])
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK"],
+        modifiers=["Op2Add"],
+        prefix=0xF3,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=lambda sz: [Operand(type="Mem", size=sz//ratio, relaxed=True,
+                                     dest="EA"),
+                             Operand(type="EVEXReg", size=sz, dest="Spare")])
+
+for sfx, group, op in [("wb", "avx512_pmov2_bw", 0x30),
+                       ("db", "avx512_pmov4", 0x31),
+                       ("qb", "avx512_pmov8", 0x32),
+                       ("dw", "avx512_pmov2", 0x33),
+                       ("qw", "avx512_pmov4", 0x34),
+                       ("qd", "avx512_pmov2", 0x35)]:
+    add_insn("vpmov"+sfx, group, modifiers=[op])
+    add_insn("vpmovs"+sfx, group, modifiers=[op-0x10])
+    add_insn("vpmovus"+sfx, group, modifiers=[op-0x20])
+
+# Between opmask and vector registers, one mask bit per element
+for elem in "bwdq":
+    cpu, w, bcst = evex_int[elem]
+    if elem in "dq":
+        cpu = "AVX512DQ"
+    op = (elem in "bw") and 0x28 or 0x38
+    add_evex_group("avx512_pmovm2"+elem,
+        cpu=[cpu],
+        evexw=w,
+        prefix=0xF3,
+        opcode=[0x0F, 0x38, op],
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="Spare"),
+                             Operand(type="KReg", size=64, dest="EA")])
+    add_evex_group("avx512_pmov2m"+elem,
+        cpu=[cpu],
+        evexw=w,
+        prefix=0xF3,
+        opcode=[0x0F, 0x38, op+1],
+        operands=lambda sz: [Operand(type="KReg", size=64, dest="Spare"),
+                             Operand(type="EVEXReg", size=sz, dest="EA")])
+    add_insn("vpmovm2"+elem, "avx512_pmovm2"+elem)
+    add_insn("vpmov%s2m" % elem, "avx512_pmov2m"+elem)
+
+# Compress to and expand from contiguous elements; compressed disp8 is
+# scaled by the element, not the vector.
+for elem in ["d", "q"]:
+    w, bcst = evex_w[elem]
+    add_evex_group("avx512_compress_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO"],
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="EA"),
+                             Operand(type="EVEXReg", size=sz, dest="Spare")])
+    add_evex_group("avx512_compress_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ELEM"],
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=lambda sz: [Operand(type="Mem", size=sz, relaxed=True,
+                                     dest="EA"),
+                             Operand(type="EVEXReg", size=sz, dest="Spare")])
+    add_evex_group("avx512_expand_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", "ELEM"],
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=evex_xmm_xmm)
+    fp = (elem == "d") and "ps" or "pd"
+    add_insn("vpcompress"+elem, "avx512_compress_"+elem, modifiers=[0x8B])
+    add_insn("vcompress"+fp, "avx512_compress_"+elem, modifiers=[0x8A])
+    add_insn("vpexpand"+elem, "avx512_expand_"+elem, modifiers=[0x89])
+    add_insn("vexpand"+fp, "avx512_expand_"+elem, modifiers=[0x88])
+
+#
+# Broadcasts
+#
+for name, cpu, w, memsz, sizes in [
+        ("vbroadcastss", "AVX512F", 0, 32, [128, 256, 512]),
+        ("vbroadcastsd", "AVX512F", 1, 64, [256, 512]),
+        ("vpbroadcastb_avx2", "AVX512BW", 0, 8, [128, 256, 512]),
+        ("vpbroadcastw_avx2", "AVX512BW", 0, 16, [128, 256, 512]),
+        ("vpbroadcastd_avx2", "AVX512F", 0, 32, [128, 256, 512]),
+        ("vpbroadcastq_avx2", "AVX512F", 1, 64, [128, 256, 512])]:
+    opcode = groups[name][0].opcode
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"],
+        sizes=sizes,
+        evexw=w,
+        prefix=0x66,
+        opcode=opcode,
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="Spare"),
+                             Operand(type="EVEXReg", size=128, dest="EA")])
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"],
+        sizes=sizes,
+        evexw=w,
+        prefix=0x66,
+        opcode=opcode,
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="Spare"),
+                             Operand(type="Mem", size=memsz, relaxed=True,
+                                     dest="EA")])
+
+# From a general purpose register (byte and word take a 32-bit register)
+for name, cpu, w, op, regsz in [
+        ("vpbroadcastb_avx2", "AVX512BW", 0, 0x7A, 32),
+        ("vpbroadcastw_avx2", "AVX512BW", 0, 0x7B, 32),
+        ("vpbroadcastd_avx2", "AVX512F", 0, 0x7C, 32),
+        ("vpbroadcastq_avx2", "AVX512F", 1, 0x7C, 64)]:
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, op],
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="Spare"),
+                             Operand(type="Reg", size=regsz, dest="EA")])
+
+# Pairs of 32-bit elements
+for name, op, sizes in [("vbroadcastf32x2", 0x19, [256, 512]),
+                        ("vbroadcasti32x2", 0x59, [128, 256, 512])]:
+    for src in [Operand(type="EVEXReg", size=128, dest="EA"),
+                Operand(type="Mem", size=64, relaxed=True, dest="EA")]:
+        add_evex_group(name,
+            cpu=["AVX512DQ"],
+            evex_flags=["MASK", "ZERO"],
+            sizes=sizes,
+            evexw=0,
+            prefix=0x66,
+            opcode=[0x0F, 0x38, op],
+            operands=lambda sz: [Operand(type="EVEXReg", size=sz,
+                                         dest="Spare"), src])
+    add_insn(name, name)
+
+#
+# Conversions widening 32-bit elements to 64 bits
+#
+for name, rounding in [("avx_cvt_xmm64_ps", "SAE"), ("avx_cvt_xmm64_dq", None)]:
+    copy_group(name, "avx_cvt_xmm64")
+    add_evex_group(name,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO"],
+        sizes=[128],
+        modifiers=["PreAdd", "Op1Add"],
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=128, dest="Spare"),
+                             Operand(type="EVEXReg", size=128, dest="EA")])
+    add_evex_group(name,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", "B32"],
+        sizes=[128],
+        modifiers=["PreAdd", "Op1Add"],
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=128, dest="Spare"),
+                             Operand(type="Mem", size=64, relaxed=True,
+                                     dest="EA")])
+    add_evex_group(name,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", "B32"],
+        rounding=rounding,
+        sizes=[256, 512],
+        modifiers=["PreAdd", "Op1Add"],
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="Spare"),
+                             Operand(type="EVEXRM", size=sz//2, relaxed=True,
+                                     dest="EA")])
+retire_group("avx_cvt_xmm64")
+
+#
+# Conversions narrowing 64-bit elements to 32 bits
+#
+# The 512-bit source converts to a ymm register.
+for name, rounding in [("avx_cvt_xmm128_er", "ER"),
+                       ("avx_cvt_xmm128_sae", "SAE")]:
+    copy_group(name, "avx_cvt_xmm128")
+for name, rounding, sizes in [("avx_cvt_xmm128_er", "ER", [128, 256, 512]),
+                              ("avx_cvt_xmm128_sae", "SAE", [128, 256, 512]),
+                              ("avx_cvt_xmm128_x", None, [128]),
+                              ("avx_cvt_xmm128_y", None, [256])]:
+    add_evex_group(name,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", "B64"],
+        rounding=rounding,
+        sizes=sizes,
+        modifiers=["PreAdd", "Op1Add"],
+        evexw=1,
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=max(sz//2, 128),
+                                     dest="Spare"),
+                             Operand(type="EVEXRM", size=sz, dest="EA")])
+retire_group("avx_cvt_xmm128")
+
+#
+# Shifts
+#
+# By an xmm/m128 count or an immediate; vpsraq has no VEX form.
+for name, cpu, elem in [("vpshift_w", "AVX512BW", None),
+                        ("vpshift_d", "AVX512F", "d"),
+                        ("vpshift_q", "AVX512F", "q"),
+                        ("avx512_vpshift_q", "AVX512F", "q")]:
+    w, bcst = evex_w.get(elem, (0, None))
+    if name.startswith("vpshift"):
+        copy_group(name, "vpshift")
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"],
+        modifiers=["Op1Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="Spare"),
+                             Operand(type="EVEXReg", size=sz, dest="VEX"),
+                             Operand(type="EVEXRM", size=128, relaxed=True,
+                                     dest="EA")])
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"] + (bcst and [bcst] or []),
+        modifiers=["Gap", "Op1Add", "SpAdd"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x00],
+        spare=0,
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="VEX"),
+                             Operand(type="EVEXRM", size=sz, relaxed=True,
+                                     dest="EA"),
+                             Operand(type="Imm", size=8, relaxed=True,
+                                     dest="Imm")])
+retire_group("vpshift")
+
+add_insn("vpsraq", "avx512_vpshift_q", modifiers=[0xE2, 0x72, 4])
+
+# Per-element variable shifts
+for name, elem in [("vpshiftv_vexw0_avx2", "d"), ("vpshiftv_vexw1_avx2", "q")]:
+    w, bcst = evex_w[elem]
+    add_evex_group(name,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", bcst],
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=evex_xmm_xmm_xmm)
+
+add_insn("vpsravq", "avx512_ssse3_q", modifiers=[0x46])
+add_insn("vpsrlvw", "avx512bw_ssse3_w1", modifiers=[0x10])
+add_insn("vpsravw", "avx512bw_ssse3_w1", modifiers=[0x11])
+add_insn("vpsllvw", "avx512bw_ssse3_w1", modifiers=[0x12])
+
+#
+# Scalar moves, inserts, and extracts
+#
+for sfx, opersize, regsz in [("d", 0, 32), ("q", 64, 64)]:
+    add_group("vmov"+sfx,
+        cpu=["AVX512F"],
+        evex=128,
+        opersize=opersize,
+        prefix=0x66,
+        opcode=[0x0F, 0x6E],
+        operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+                  Operand(type="RM", size=regsz, relaxed=True, dest="EA")])
+    add_group("vmov"+sfx,
+        cpu=["AVX512F"],
+        evex=128,
+        opersize=opersize,
+        prefix=0x66,
+        opcode=[0x0F, 0x7E],
+        operands=[Operand(type="RM", size=regsz, relaxed=True, dest="EA"),
+                  Operand(type="EVEXReg", size=128, dest="Spare")])
+for src in [Operand(type="EVEXReg", size=128, dest="EA"),
+            Operand(type="Mem", size=64, relaxed=True, dest="EA")]:
+    add_group("vmovq",
+        cpu=["AVX512F"],
+        evex=128,
+        evexw=1,
+        prefix=0xF3,
+        opcode=[0x0F, 0x7E],
+        operands=[Operand(type="EVEXReg", size=128, dest="Spare"), src])
+add_group("vmovq",
+    cpu=["AVX512F"],
+    evex=128,
+    evexw=1,
+    prefix=0x66,
+    opcode=[0x0F, 0xD6],
+    operands=[Operand(type="Mem", size=64, relaxed=True, dest="EA"),
+              Operand(type="EVEXReg", size=128, dest="Spare")])
+
+# Extracts: (group, cpu, operand size, opcode, destination)
+for name, cpu, opersize, opcode, dest in [
+        ("pextrb", "AVX512BW", 0, 0x14,
+         Operand(type="Mem", size=8, relaxed=True, dest="EA")),
+        ("pextrb", "AVX512BW", 0, 0x14,
+         Operand(type="Reg", size=32, dest="EA")),
+        ("pextrw", "AVX512BW", 0, 0x15,
+         Operand(type="Mem", size=16, relaxed=True, dest="EA")),
+        ("pextrd", "AVX512DQ", 0, 0x16,
+         Operand(type="RM", size=32, relaxed=True, dest="EA")),
+        ("pextrq", "AVX512DQ", 64, 0x16,
+         Operand(type="RM", size=64, relaxed=True, dest="EA")),
+        ("extractps", "AVX512F", 0, 0x17,
+         Operand(type="RM", size=32, relaxed=True, dest="EA"))]:
+    name += "_" + cpu[6:].lower()
+    if name not in groups:
+        copy_group(name, name.split("_")[0])
+    add_group(name,
+        cpu=[cpu],
+        evex=128,
+        opersize=opersize,
+        prefix=0x66,
+        opcode=[0x0F, 0x3A, opcode],
+        operands=[dest, Operand(type="EVEXReg", size=128, dest="Spare"),
+                  Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
+add_group("pextrw_bw",
+    suffix="l",
+    cpu=["AVX512BW"],
+    evex=128,
+    prefix=0x66,
+    opcode=[0x0F, 0xC5],
+    operands=[Operand(type="Reg", size=32, dest="Spare"),
+              Operand(type="EVEXReg", size=128, dest="EA"),
+              Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
+
+# Inserts: (group, cpu, GAS suffix, operand size, opcode, source)
+for name, cpu, suffix, opersize, opcode, src in [
+        ("pinsrb", "AVX512BW", None, 0, [0x0F, 0x3A, 0x20],
+         Operand(type="Mem", size=8, relaxed=True, dest="EA")),
+        ("pinsrb", "AVX512BW", None, 0, [0x0F, 0x3A, 0x20],
+         Operand(type="Reg", size=32, dest="EA")),
+        ("pinsrw", "AVX512BW", "l", 0, [0x0F, 0xC4],
+         Operand(type="Reg", size=32, dest="EA")),
+        ("pinsrw", "AVX512BW", "l", 0, [0x0F, 0xC4],
+         Operand(type="Mem", size=16, relaxed=True, dest="EA")),
+        ("pinsrd", "AVX512DQ", None, 0, [0x0F, 0x3A, 0x22],
+         Operand(type="RM", size=32, relaxed=True, dest="EA")),
+        ("pinsrq", "AVX512DQ", None, 64, [0x0F, 0x3A, 0x22],
+         Operand(type="RM", size=64, relaxed=True, dest="EA")),
+        ("insertps", "AVX512F", None, 0, [0x0F, 0x3A, 0x21],
+         Operand(type="Mem", size=32, relaxed=True, dest="EA")),
+        ("insertps", "AVX512F", None, 0, [0x0F, 0x3A, 0x21],
+         Operand(type="EVEXReg", size=128, dest="EA"))]:
+    name += "_" + cpu[6:].lower()
+    if name not in groups:
+        copy_group(name, name.split("_")[0])
+    add_group(name,
+        suffix=suffix,
+        cpu=[cpu],
+        evex=128,
+        opersize=opersize,
+        prefix=0x66,
+        opcode=opcode,
+        operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+                  Operand(type="EVEXReg", size=128, dest="VEX"), src,
+                  Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
+
+# Ordered and unordered compares into EFLAGS
+for name, w, memsz in [("avx_xmm_xmm32", 0, 32), ("avx_xmm_xmm64", 1, 64)]:
+    add_group(name,
+        cpu=["AVX512F"],
+        evex_flags=["SAE"],
+        modifiers=["PreAdd", "Op1Add"],
+        evex=128,
+        evexw=w,
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+                  Operand(type="EVEXReg", size=128, dest="EA")])
+    add_group(name,
+        cpu=["AVX512F"],
+        modifiers=["PreAdd", "Op1Add"],
+        evex=128,
+        evexw=w,
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+                  Operand(type="Mem", size=memsz, relaxed=True, dest="EA")])
+
+#
+# Shuffles
+#
+for elem in ["ps", "pd"]:
+    w, bcst = evex_w[elem]
+    copy_group("xmm_xmm128_imm_256_"+elem, "xmm_xmm128_imm_256")
+    add_evex_group("xmm_xmm128_imm_256_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", bcst],
+        modifiers=["PreAdd", "Op1Add"],
+        evexw=w,
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=evex_xmm_xmm_xmm_imm)
+retire_group("xmm_xmm128_imm_256")
+
+for name, cpu, bcst in [("xmm_xmm128_imm_256avx2_d", "AVX512F", ["B32"]),
+                        ("xmm_xmm128_imm_256avx2_bw", "AVX512BW", [])]:
+    copy_group(name, "xmm_xmm128_imm_256avx2")
+    add_evex_group(name,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"] + bcst,
+        modifiers=["PreAdd", "Op1Add"],
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=evex_xmm_xmm_imm)
+retire_group("xmm_xmm128_imm_256avx2")
+
+copy_group("sse4imm_256avx2_bw", "sse4imm_256avx2")
+add_evex_group("sse4imm_256avx2_bw",
+    cpu=["AVX512BW"],
+    evex_flags=["MASK", "ZERO"],
+    modifiers=["Op2Add"],
+    prefix=0x66,
+    opcode=[0x0F, 0x3A, 0x00],
+    operands=evex_xmm_xmm_xmm_imm)
+
+# Byte shifts of each 128-bit lane; EVEX allows a memory source.
+copy_group("pslrldq_bw", "pslrldq")
+add_evex_group("pslrldq_bw",
+    cpu=["AVX512BW"],
+    modifiers=["SpAdd"],
+    prefix=0x66,
+    opcode=[0x0F, 0x73],
+    spare=0,
+    operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="VEX"),
+                         Operand(type="EVEXRM", size=sz, relaxed=True,
+                                 dest="EA"),
+                         Operand(type="Imm", size=8, relaxed=True,
+                                 dest="Imm")])
+
+# Shuffles of 128-bit lanes
+for elem in ["d", "q"]:
+    w, bcst = evex_w[elem]
+    add_evex_group("avx512_shuf_lane_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", bcst],
+        sizes=[256, 512],
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x3A, 0x00],
+        operands=evex_xmm_xmm_xmm_imm)
+
+add_insn("vshuff32x4", "avx512_shuf_lane_d", modifiers=[0x23])
+add_insn("vshuff64x2", "avx512_shuf_lane_q", modifiers=[0x23])
+add_insn("vshufi32x4", "avx512_shuf_lane_d", modifiers=[0x43])
+add_insn("vshufi64x2", "avx512_shuf_lane_q", modifiers=[0x43])
+
+#
+# Permutes
+#
+add_evex_group("vperm_var_avx2",
+    cpu=["AVX512F"],
+    evex_flags=["MASK", "ZERO", "B32"],
+    sizes=[256, 512],
+    modifiers=["Op2Add"],
+    evexw=0,
+    prefix=0x66,
+    opcode=[0x0F, 0x38, 0x00],
+    operands=evex_xmm_xmm_xmm)
+
+# vpermq and vpermpd gain a variable (table in a register) form; its
+# opcode is the second modifier.
+add_evex_group("vperm_imm_avx2",
+    cpu=["AVX512F"],
+    evex_flags=["MASK", "ZERO", "B64"],
+    sizes=[256, 512],
+    modifiers=["Op2Add"],
+    evexw=1,
+    prefix=0x66,
+    opcode=[0x0F, 0x3A, 0x00],
+    operands=evex_xmm_xmm_imm)
+add_evex_group("vperm_imm_avx2",
+    cpu=["AVX512F"],
+    evex_flags=["MASK", "ZERO", "B64"],
+    sizes=[256, 512],
+    modifiers=["Gap", "Op2Add"],
+    evexw=1,
+    prefix=0x66,
+    opcode=[0x0F, 0x38, 0x00],
+    operands=evex_xmm_xmm_xmm)
+
+for elem in ["ps", "pd"]:
+    w, bcst = evex_w[elem]
+    copy_group("vpermil_"+elem, "vpermil")
+    add_evex_group("vpermil_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", bcst],
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x08],
+        operands=evex_xmm_xmm_xmm)
+    add_evex_group("vpermil_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", bcst],
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x3A, 0x00],
+        operands=evex_xmm_xmm_imm)
+retire_group("vpermil")
+
+for name, op in [("vpermi2", 0x76), ("vpermt2", 0x7E)]:
+    add_insn(name+"w", "avx512bw_ssse3_w1", modifiers=[op-1])
+    add_insn(name+"d", "avx512_ssse3_d", modifiers=[op])
+    add_insn(name+"q", "avx512_ssse3_q", modifiers=[op])
+    add_insn(name+"ps", "avx512_ssse3_d", modifiers=[op+1])
+    add_insn(name+"pd", "avx512_ssse3_q", modifiers=[op+1])
+add_insn("vpermw", "avx512bw_ssse3_w1", modifiers=[0x8D])
+
+#
+# 128 and 256-bit lane extract, insert, and broadcast
+#
+for sfx, cpu, w, part, sizes in [("32x4", "AVX512F", 0, 128, [256, 512]),
+                                 ("64x2", "AVX512DQ", 1, 128, [256, 512]),
+                                 ("32x8", "AVX512DQ", 0, 256, [512]),
+                                 ("64x4", "AVX512F", 1, 256, [512])]:
+    add_evex_group("avx512_extract_"+sfx,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"],
+        sizes=sizes,
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x3A, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=part, dest="EA"),
+                             Operand(type="EVEXReg", size=sz, dest="Spare"),
+                             Operand(type="Imm", size=8, relaxed=True,
+                                     dest="Imm")])
+    add_evex_group("avx512_extract_"+sfx,
+        cpu=[cpu],
+        evex_flags=["MASK"],
+        sizes=sizes,
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x3A, 0x00],
+        operands=lambda sz: [Operand(type="Mem", size=part, relaxed=True,
+                                     dest="EA"),
+                             Operand(type="EVEXReg", size=sz, dest="Spare"),
+                             Operand(type="Imm", size=8, relaxed=True,
+                                     dest="Imm")])
+    add_evex_group("avx512_insert_"+sfx,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"],
+        sizes=sizes,
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x3A, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="Spare"),
+                             Operand(type="EVEXReg", size=sz, dest="VEX"),
+                             Operand(type="EVEXRM", size=part, relaxed=True,
+                                     dest="EA"),
+                             Operand(type="Imm", size=8, relaxed=True,
+                                     dest="Imm")])
+    add_evex_group("avx512_bcst_"+sfx,
+        cpu=[cpu],
+        evex_flags=["MASK", "ZERO"],
+        sizes=sizes,
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=sz, dest="Spare"),
+                             Operand(type="Mem", size=part, relaxed=True,
+                                     dest="EA")])
+    op = (part == 128) and 0x19 or 0x1B
+    add_insn("vbroadcastf"+sfx, "avx512_bcst_"+sfx,
+             modifiers=[(part == 128) and 0x1A or 0x1B])
+    add_insn("vbroadcasti"+sfx, "avx512_bcst_"+sfx,
+             modifiers=[(part == 128) and 0x5A or 0x5B])
+    add_insn("vextractf"+sfx, "avx512_extract_"+sfx, modifiers=[op])
+    add_insn("vextracti"+sfx, "avx512_extract_"+sfx, modifiers=[op+0x20])
+    add_insn("vinsertf"+sfx, "avx512_insert_"+sfx, modifiers=[op-1])
+    add_insn("vinserti"+sfx, "avx512_insert_"+sfx, modifiers=[op+0x1F])
+
+#
+# Gathers and scatters
+#
+# The memory operand is sized by its element, and the index register type
+# and destination size follow from the vector length: (gather group,
+# scatter group, EVEX.W, element size, index for 128/256/512, data
+# register size for 128/256/512).
+for gather, scatter, w, memsz, index, regsz in [
+        ("gather_32x_32y", "scatter_32x_32y", 0, 32,
+         ["XMM", "YMM", "ZMM"], [128, 256, 512]),
+        ("gather_64x_64x", "scatter_64x_64x", 1, 64,
+         ["XMM", "XMM", "YMM"], [128, 256, 512]),
+        ("gather_64x_64y", "scatter_64x_64y", 1, 64,
+         ["XMM", "YMM", "ZMM"], [128, 256, 512]),
+        ("gather_32x_32y_128", "scatter_32x_32y_128", 0, 32,
+         ["XMM", "YMM", "ZMM"], [128, 128, 256])]:
+    form = lambda sz: [128, 256, 512].index(sz)
+    add_evex_group(gather,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "MASKREQ"],
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=lambda sz: [Operand(type="EVEXReg", size=regsz[form(sz)],
+                                     dest="Spare"),
+                             Operand(type="Mem%sIndex" % index[form(sz)],
+                                     size=memsz, relaxed=True, dest="EA")])
+    add_evex_group(scatter,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "MASKREQ"],
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=lambda sz: [Operand(type="Mem%sIndex" % index[form(sz)],
+                                     size=memsz, relaxed=True, dest="EA"),
+                             Operand(type="EVEXReg", size=regsz[form(sz)],
+                                     dest="Spare")])
+
+for sfx, scatter, op in [("dd", "scatter_32x_32y", 0xA0),
+                         ("dq", "scatter_64x_64x", 0xA0),
+                         ("qd", "scatter_32x_32y_128", 0xA1),
+                         ("qq", "scatter_64x_64y", 0xA1)]:
+    add_insn("vpscatter"+sfx, scatter, modifiers=[op])
+    add_insn("vscatter%sp%s" % (sfx[0], sfx[1] == "d" and "s" or "d"),
+             scatter, modifiers=[op+2])
+
+#
+# Floating point approximations, exponents, rounding, and classification
+#
+# Packed: (group, cpu, opcode map, operands, rounding)
+for elem in ["d", "q"]:
+    w, bcst = evex_w[elem]
+    for name, cpu, opmap, operands, rounding in [
+            ("avx512_ssse3_2op_%s_sae", "AVX512F", 0x38, evex_xmm_xmm, "SAE"),
+            ("avx512_ssse3_%s_er", "AVX512F", 0x38, evex_xmm_xmm_xmm, "ER"),
+            ("avx512_sse4imm_2op_%s_sae", "AVX512F", 0x3A, evex_xmm_xmm_imm,
+             "SAE"),
+            ("avx512dq_sse4imm_2op_%s_sae", "AVX512DQ", 0x3A,
+             evex_xmm_xmm_imm, "SAE"),
+            ("avx512dq_sse4imm_%s_sae", "AVX512DQ", 0x3A,
+             evex_xmm_xmm_xmm_imm, "SAE")]:
+        add_evex_group(name % elem,
+            cpu=[cpu],
+            evex_flags=["MASK", "ZERO", bcst],
+            rounding=rounding,
+            modifiers=["Op2Add"],
+            evexw=w,
+            prefix=0x66,
+            opcode=[0x0F, opmap, 0x00],
+            operands=operands)
+    # The memory operand size can't be inferred from the mask destination.
+    add_evex_group("avx512_fpclass_"+elem,
+        cpu=["AVX512DQ"],
+        evex_flags=["MASK", bcst],
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x3A, 0x00],
+        operands=lambda sz: [Operand(type="KReg", size=64, dest="Spare"),
+                             Operand(type="EVEXRM", size=sz, dest="EA"),
+                             Operand(type="Imm", size=8, relaxed=True,
+                                     dest="Imm")])
+
+# Scalar: (group, cpu, opcode map, immediate, rounding)
+for elem, w, memsz in [("ss", 0, 32), ("sd", 1, 64)]:
+    for name, cpu, opmap, imm, rounding in [
+            ("avx512_ssse3_%s", "AVX512F", 0x38, [], []),
+            ("avx512_ssse3_%s_sae", "AVX512F", 0x38, [], ["SAE"]),
+            ("avx512_ssse3_%s_er", "AVX512F", 0x38, [], ["ER"]),
+            ("avx512_sse4imm_%s_sae", "AVX512F", 0x3A,
+             [Operand(type="Imm", size=8, relaxed=True, dest="Imm")],
+             ["SAE"]),
+            ("avx512dq_sse4imm_%s_sae", "AVX512DQ", 0x3A,
+             [Operand(type="Imm", size=8, relaxed=True, dest="Imm")],
+             ["SAE"])]:
+        for src, flags in [(Operand(type="EVEXReg", size=128, dest="EA"),
+                            rounding),
+                           (Operand(type="Mem", size=memsz, relaxed=True,
+                                    dest="EA"), [])]:
+            add_group(name % elem,
+                cpu=[cpu],
+                evex_flags=["MASK", "ZERO"] + flags,
+                modifiers=["Op2Add"],
+                evex=128,
+                evexw=w,
+                prefix=0x66,
+                opcode=[0x0F, opmap, 0x00],
+                operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+                          Operand(type="EVEXReg", size=128, dest="VEX"),
+                          src] + imm)
+    for src in [Operand(type="EVEXReg", size=128, dest="EA"),
+                Operand(type="Mem", size=memsz, relaxed=True, dest="EA")]:
+        add_group("avx512_fpclass_"+elem,
+            cpu=["AVX512DQ"],
+            evex_flags=["MASK"],
+            modifiers=["Op2Add"],
+            evex=128,
+            evexw=w,
+            prefix=0x66,
+            opcode=[0x0F, 0x3A, 0x00],
+            operands=[Operand(type="KReg", size=64, dest="Spare"), src,
+                      Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
+
+for ps, ss, elem in [("ps", "ss", "d"), ("pd", "sd", "q")]:
+    one = (elem == "q") and 1 or 0
+    add_insn("vrcp14"+ps, "avx512_ssse3_2op_"+elem, modifiers=[0x4C])
+    add_insn("vrcp14"+ss, "avx512_ssse3_"+ss, modifiers=[0x4D])
+    add_insn("vrsqrt14"+ps, "avx512_ssse3_2op_"+elem, modifiers=[0x4E])
+    add_insn("vrsqrt14"+ss, "avx512_ssse3_"+ss, modifiers=[0x4F])
+    add_insn("vgetexp"+ps, "avx512_ssse3_2op_%s_sae" % elem, modifiers=[0x42])
+    add_insn("vgetexp"+ss, "avx512_ssse3_%s_sae" % ss, modifiers=[0x43])
+    add_insn("vscalef"+ps, "avx512_ssse3_%s_er" % elem, modifiers=[0x2C])
+    add_insn("vscalef"+ss, "avx512_ssse3_%s_er" % ss, modifiers=[0x2D])
+    add_insn("vrndscale"+ps, "avx512_sse4imm_2op_%s_sae" % elem,
+             modifiers=[0x08+one])
+    add_insn("vrndscale"+ss, "avx512_sse4imm_%s_sae" % ss,
+             modifiers=[0x0A+one])
+    add_insn("vgetmant"+ps, "avx512_sse4imm_2op_%s_sae" % elem,
+             modifiers=[0x26])
+    add_insn("vgetmant"+ss, "avx512_sse4imm_%s_sae" % ss, modifiers=[0x27])
+    add_insn("vreduce"+ps, "avx512dq_sse4imm_2op_%s_sae" % elem,
+             modifiers=[0x56])
+    add_insn("vreduce"+ss, "avx512dq_sse4imm_%s_sae" % ss, modifiers=[0x57])
+    add_insn("vrange"+ps, "avx512dq_sse4imm_%s_sae" % elem, modifiers=[0x50])
+    add_insn("vrange"+ss, "avx512dq_sse4imm_%s_sae" % ss, modifiers=[0x51])
+    add_insn("vfpclass"+ps, "avx512_fpclass_"+elem, modifiers=[0x66])
+    add_insn("vfpclass"+ss, "avx512_fpclass_"+ss, modifiers=[0x67])
+
+#
+# FMA
+#
+for elem in ["ps", "pd"]:
+    w, bcst = evex_w[elem]
+    add_evex_group("vfma_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", bcst],
+        rounding="ER",
+        modifiers=["Op2Add"],
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=evex_xmm_xmm_xmm)
+
+for elem, w, memsz in [("ss", 0, 32), ("sd", 1, 64)]:
+    add_group("vfma_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO", "ER"],
+        modifiers=["Op2Add"],
+        evex=128,
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+                  Operand(type="EVEXReg", size=128, dest="VEX"),
+                  Operand(type="EVEXReg", size=128, dest="EA")])
+    add_group("vfma_"+elem,
+        cpu=["AVX512F"],
+        evex_flags=["MASK", "ZERO"],
+        modifiers=["Op2Add"],
+        evex=128,
+        evexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x38, 0x00],
+        operands=[Operand(type="EVEXReg", size=128, dest="Spare"),
+                  Operand(type="EVEXReg", size=128, dest="VEX"),
+                  Operand(type="Mem", size=memsz, relaxed=True, dest="EA")])
+
+#
+# Opmask register instructions (VEX encoded)
+#
+for w in [0, 1]:
+    add_group("k_k_k_w%d" % w,
+        cpu=["AVX512F"],
+        modifiers=["PreAdd", "Op1Add"],
+        vex=256,
+        vexw=w,
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=[Operand(type="KReg", size=64, dest="Spare"),
+                  Operand(type="KReg", size=64, dest="VEX"),
+                  Operand(type="KReg", size=64, dest="EA")])
+    add_group("k_k_w%d" % w,
+        cpu=["AVX512F"],
+        modifiers=["PreAdd", "Op1Add"],
+        vex=128,
+        vexw=w,
+        prefix=0x00,
+        opcode=[0x0F, 0x00],
+        operands=[Operand(type="KReg", size=64, dest="Spare"),
+                  Operand(type="KReg", size=64, dest="EA")])
+    add_group("k_k_imm_w%d" % w,
+        cpu=["AVX512F"],
+        modifiers=["Op2Add"],
+        vex=128,
+        vexw=w,
+        prefix=0x66,
+        opcode=[0x0F, 0x3A, 0x00],
+        operands=[Operand(type="KReg", size=64, dest="Spare"),
+                  Operand(type="KReg", size=64, dest="EA"),
+                  Operand(type="Imm", size=8, relaxed=True, dest="Imm")])
+
+# kmovX: (suffix, cpu, k/mem prefix, k/mem W, memory size, GPR prefix,
+# GPR W, GPR size)
+for sfx, cpu, kpre, kw, memsz, rpre, rw, rsz in [
+        ("b", "AVX512DQ", 0x66, 0, 8, 0x66, 0, 32),
+        ("w", "AVX512F", 0x00, 0, 16, 0x00, 0, 32),
+        ("d", "AVX512BW", 0x66, 1, 32, 0xF2, 0, 32),
+        ("q", "AVX512BW", 0x00, 1, 64, 0xF2, 1, 64)]:
+    add_group("kmov"+sfx,
+        cpu=[cpu],
+        vex=128,
+        vexw=kw,
+        prefix=kpre,
+        opcode=[0x0F, 0x90],
+        operands=[Operand(type="KReg", size=64, dest="Spare"),
+                  Operand(type="KReg", size=64, dest="EA")])
+    add_group("kmov"+sfx,
+        cpu=[cpu],
+        vex=128,
+        vexw=kw,
+        prefix=kpre,
+        opcode=[0x0F, 0x90],
+        operands=[Operand(type="KReg", size=64, dest="Spare"),
+                  Operand(type="Mem", size=memsz, relaxed=True, dest="EA")])
+    add_group("kmov"+sfx,
+        cpu=[cpu],
+        vex=128,
+        vexw=kw,
+        prefix=kpre,
+        opcode=[0x0F, 0x91],
+        operands=[Operand(type="Mem", size=memsz, relaxed=True, dest="EA"),
+                  Operand(type="KReg", size=64, dest="Spare")])
+    add_group("kmov"+sfx,
+        cpu=[cpu],
+        vex=128,
+        vexw=rw,
+        prefix=rpre,
+        opcode=[0x0F, 0x92],
+        operands=[Operand(type="KReg", size=64, dest="Spare"),
+                  Operand(type="Reg", size=rsz, dest="EA")])
+    add_group("kmov"+sfx,
+        cpu=[cpu],
+        vex=128,
+        vexw=rw,
+        prefix=rpre,
+        opcode=[0x0F, 0x93],
+        operands=[Operand(type="Reg", size=rsz, dest="Spare"),
+                  Operand(type="KReg", size=64, dest="EA")])
+    add_insn("kmov"+sfx, "kmov"+sfx)
+
+# Other opmask operations: (suffix, cpu, prefix, W)
+for sfx, cpu, pre, w in [("b", "AVX512DQ", 0x66, 0), ("w", "AVX512F", 0, 0),
+                         ("d", "AVX512BW", 0x66, 1), ("q", "AVX512BW", 0, 1)]:
+    for name, op in [("kand", 0x41), ("kandn", 0x42), ("kor", 0x45),
+                     ("kxnor", 0x46), ("kxor", 0x47)]:
+        add_insn(name+sfx, "k_k_k_w%d" % w, modifiers=[pre, op], cpu=[cpu])
+    for name, op in [("knot", 0x44), ("kortest", 0x98)]:
+        add_insn(name+sfx, "k_k_w%d" % w, modifiers=[pre, op], cpu=[cpu])
+
+# kadd and ktest start at AVX512DQ for both the byte and word forms.
+for sfx, cpu, pre, w in [("b", "AVX512DQ", 0x66, 0), ("w", "AVX512DQ", 0, 0),
+                         ("d", "AVX512BW", 0x66, 1), ("q", "AVX512BW", 0, 1)]:
+    add_insn("kadd"+sfx, "k_k_k_w%d" % w, modifiers=[pre, 0x4A], cpu=[cpu])
+    add_insn("ktest"+sfx, "k_k_w%d" % w, modifiers=[pre, 0x99], cpu=[cpu])
+
+# kunpckXY: (suffixes, cpu, prefix, W)
+for sfx, cpu, pre, w in [("bw", "AVX512F", 0x66, 0), ("wd", "AVX512BW", 0, 0),
+                         ("dq", "AVX512BW", 0, 1)]:
+    add_insn("kunpck"+sfx, "k_k_k_w%d" % w, modifiers=[pre, 0x4B], cpu=[cpu])
+
+# kshiftX: (suffix, cpu, opcode offset, W)
+for sfx, cpu, op, w in [("b", "AVX512DQ", 0, 0), ("w", "AVX512F", 0, 1),
+                        ("d", "AVX512BW", 1, 0), ("q", "AVX512BW", 1, 1)]:
+    add_insn("kshiftr"+sfx, "k_k_imm_w%d" % w, modifiers=[0x30+op], cpu=[cpu])
+    add_insn("kshiftl"+sfx, "k_k_imm_w%d" % w, modifiers=[0x32+op], cpu=[cpu])
+
 finalize_insns()
 
 #####################################################################
@@ -0,0 +1,21 @@
+bits 64
+top:
+	times 27 nop
+	cmp eax, 1		; cmp+jne would end on the boundary
+	jne top
+	times 28 nop
+	jmp near fwd
+	times 25 nop
+	call top		; would cross the boundary
+	dec ecx
+	jnz top
+	times 95 nop
+	add eax, [rbx]
+	jz top			; fused with the add
+	times 200 nop
+fwd:
+	test eax, eax
+	jz top
+	cmp dword [rax], 1	; memory-immediate compare isn't fused
+	jz top
+	ret
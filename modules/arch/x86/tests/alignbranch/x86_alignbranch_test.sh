@@ -0,0 +1,3 @@
+#! /bin/sh
+${srcdir}/out_test.sh x86_alignbranch_test modules/arch/x86/tests/alignbranch "x86 branch alignment" "--align-branches-within=32 -f bin" ""
+exit $?
@@ -0,0 +1,19 @@
+bits 64
+loops:
+	mov ecx, 10
+	jmp .fwd		; forward only: not a loop head
+.top:
+	add eax, ecx
+	dec ecx
+	jnz .top
+	nop
+.fwd:
+	xor eax, eax
+	times 3 nop
+.l2:				; needs more than the maximum skip
+	inc eax
+	cmp eax, 100
+	jb .l2
+	jmp .l2
+	call .fwd		; calls don't make loop heads
+	ret
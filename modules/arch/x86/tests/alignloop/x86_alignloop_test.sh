@@ -0,0 +1,3 @@
+#! /bin/sh
+${srcdir}/out_test.sh x86_alignloop_test modules/arch/x86/tests/alignloop "x86 loop alignment" "--align-loops=16:10 -f bin" ""
+exit $?
@@ -0,0 +1,18 @@
+[bits 64]
+vaddps zmm1{k0}, zmm2, zmm3		; k0 is not a write mask
+vaddps zmm1{z}, zmm2, zmm3{k1}		; mask on a source operand
+vaddsubps ymm1{k1}, ymm2, ymm3		; no EVEX form
+vaddps zmm1, zmm2, [rax]{1to8}		; broadcast doesn't fill the vector
+vaddps zmm1, zmm2, [rax], {rn-sae}	; rounding needs register operands
+vandps zmm1, zmm2, zmm3, {sae}		; no SAE form
+vaddps zmm1{z}, zmm2, zmm3		; zeroing without a write mask
+vaddps zmm1{k0}{z}, zmm2, zmm3		; or with k0
+vpgatherdd zmm1, [rax+zmm2*4]		; gathers need a write mask
+vpscatterdd [rax+zmm2*4], zmm1		; and so do scatters
+vpgatherdd xmm1, [rax+xmm17*4], xmm3	; no VEX form with xmm16-31
+vpbroadcastb xmm1, al			; GPR source must be 32-bit
+vextractf32x4 [rax]{k1}{z}, zmm2, 1	; no zeroing on a memory destination
+vgatherdps zmm1{k1}, [rax+zmm1*4]	; destination is the index register
+vpgatherdq zmm2{k1}, [rax+ymm2*8]	; even at a different size
+vpmovm2d zmm1{k1}, k1			; no write mask on mask conversions
+vfpclassps k1, [rax], 1			; memory size is needed
@@ -0,0 +1,421 @@
+; AVX-512 (EVEX) instruction encodings
+
+[bits 64]
+
+vaddps zmm0, zmm1, zmm2			; 62 f1 74 48 58 c2
+vaddps zmm16, zmm17, zmm31		; 62 81 74 40 58 c7
+vaddps xmm0, xmm1, xmm2			; c5 f0 58 c2
+vaddps xmm16, xmm1, xmm2		; 62 e1 74 08 58 c2
+vaddps ymm1{k1}, ymm2, ymm3		; 62 f1 6c 29 58 cb
+vaddps zmm1{k2}{z}, zmm2, [rax]		; 62 f1 6c ca 58 08
+vaddps zmm1, zmm2, [rax+64]		; 62 f1 6c 48 58 48 01
+vaddps zmm1, zmm2, [rax+128]		; 62 f1 6c 48 58 48 02
+vaddps zmm1, zmm2, [rax+100]		; 62 f1 6c 48 58 88 64 00 00 00
+vaddps zmm1, zmm2, [rax+4]{1to16}	; 62 f1 6c 58 58 48 01
+vaddpd zmm1, zmm2, [rax+8]{1to8}	; 62 f1 ed 58 58 48 01
+vaddps zmm1, zmm2, zmm3, {rz-sae}	; 62 f1 6c 78 58 cb
+vaddpd zmm9, zmm12, zmm3		; 62 71 9d 48 58 cb
+vmaxps zmm1, zmm2, zmm3, {sae}		; 62 f1 6c 18 5f cb
+vaddss xmm1{k1}, xmm2, xmm3		; 62 f1 6e 09 58 cb
+vaddss xmm1, xmm2, [rax+8]		; c5 ea 58 48 08
+vaddsd xmm1, xmm2, xmm3, {rd-sae}	; 62 f1 ef 38 58 cb
+vsqrtps zmm1, zmm2			; 62 f1 7c 48 51 ca
+vsqrtpd zmm1, [rax+128]			; 62 f1 fd 48 51 48 02
+vpaddd zmm1, zmm2, zmm3			; 62 f1 6d 48 fe cb
+vpaddq zmm1, zmm2, [rax]{1to8}		; 62 f1 ed 58 d4 08
+vpaddb zmm1, zmm2, zmm3			; 62 f1 6d 48 fc cb
+vpandd zmm1, zmm2, zmm3			; 62 f1 6d 48 db cb
+vpxorq ymm1, ymm2, ymm20		; 62 b1 ed 28 ef cc
+vpmulld zmm1, zmm2, zmm3		; 62 f2 6d 48 40 cb
+vpmullq zmm1, zmm2, zmm3		; 62 f2 ed 48 40 cb
+vandps zmm1, zmm2, zmm3			; 62 f1 6c 48 54 cb
+vplzcntd zmm1, zmm2			; 62 f2 7d 48 44 ca
+vpconflictq zmm1{k3}, [rax]		; 62 f2 fd 4b c4 08
+vpternlogd zmm1, zmm2, zmm3, 0x55	; 62 f3 6d 48 25 cb 55
+vpcmpeqd k1, zmm2, zmm3			; 62 f1 6d 48 76 cb
+vpcmpeqq k1{k2}, zmm2, [rax]		; 62 f2 ed 4a 29 08
+vcmpps k1, zmm2, zmm3, 1		; 62 f1 6c 48 c2 cb 01
+vcmppd k1, zmm2, zmm3, {sae}, 1		; 62 f1 ed 18 c2 cb 01
+vmovaps zmm1, [rax]			; 62 f1 7c 48 28 08
+vmovaps [rax+64], zmm1			; 62 f1 7c 48 29 48 01
+vmovups zmm1{k1}{z}, zmm30		; 62 91 7c c9 10 ce
+vmovdqa64 zmm1, [rax]			; 62 f1 fd 48 6f 08
+vmovdqu8 [rax]{k1}, zmm1		; 62 f1 7f 49 7f 08
+vmovdqu16 zmm17, zmm18			; 62 a1 ff 48 6f ca
+vmovdqu32 zmm1{k1}, [r9+r10*4+256]	; 62 91 7e 49 6f 4c 91 04
+vbroadcastss zmm1, xmm2			; 62 f2 7d 48 18 ca
+vbroadcastss zmm1, [rax+4]		; 62 f2 7d 48 18 48 01
+vbroadcastsd zmm1, [rax+8]		; 62 f2 fd 48 19 48 01
+vpbroadcastd zmm1{k1}, xmm2		; 62 f2 7d 49 58 ca
+vpbroadcastq zmm1, [rax]		; 62 f2 fd 48 59 08
+vfmadd231ps zmm1, zmm2, zmm3		; 62 f2 6d 48 b8 cb
+vfmadd132pd zmm1{k1}, zmm2, [rax]{1to8}	; 62 f2 ed 59 98 08
+vfmadd213ss xmm1, xmm2, xmm3, {rn-sae}	; 62 f2 6d 18 a9 cb
+vfnmadd231sd xmm1{k1}, xmm2, [rax+16]	; 62 f2 ed 09 bd 48 02
+kmovw k1, k2				; c5 f8 90 ca
+kmovw k1, [rax]				; c5 f8 90 08
+kmovw [rax], k1				; c5 f8 91 08
+kmovw k1, eax				; c5 f8 92 c8
+kmovw eax, k1				; c5 f8 93 c1
+kmovb k1, k2				; c5 f9 90 ca
+kmovd k1, eax				; c5 fb 92 c8
+kmovq k1, rax				; c4 e1 fb 92 c8
+kmovq k1, k2				; c4 e1 f8 90 ca
+kandw k1, k2, k3			; c5 ec 41 cb
+kxorq k1, k2, k3			; c4 e1 ec 47 cb
+knotw k1, k2				; c5 f8 44 ca
+kortestw k1, k2				; c5 f8 98 ca
+vaddps zmm1, zmm2, [rax+rbx*8-8192]	; 62 f1 6c 48 58 4c d8 80
+vaddps zmm1, zmm2, [rax-8256]		; 62 f1 6c 48 58 88 c0 df ff ff
+vaddps zmm1, zmm2, [rbp]		; 62 f1 6c 48 58 4d 00
+vpcmpeqb k1, zmm2, zmm3			; 62 f1 6d 48 74 cb
+vpcmpeqw k2{k3}, ymm4, [rax+64]		; 62 f1 5d 2b 75 50 02
+vpcmpgtb k1, xmm17, xmm3		; 62 f1 75 00 64 cb
+vpcmpgtw k1, zmm2, zmm3			; 62 f1 6d 48 65 cb
+vpcmpgtd k1, zmm2, [rax]{1to16}		; 62 f1 6d 58 66 08
+vpcmpgtq k1{k2}, zmm2, zmm3		; 62 f2 ed 4a 37 cb
+vpcmpeqb xmm1, xmm2, xmm3		; c5 e9 74 cb
+vpmullw zmm1, zmm2, zmm3		; 62 f1 6d 48 d5 cb
+vpmullw ymm1{k1}{z}, ymm2, [rax+32]	; 62 f1 6d a9 d5 48 01
+vpmulhuw zmm1, zmm2, zmm3		; 62 f1 6d 48 e4 cb
+vpaddusb zmm1, zmm2, zmm30		; 62 91 6d 48 dc ce
+vpavgw zmm1, zmm2, zmm3			; 62 f1 6d 48 e3 cb
+vpmaddwd zmm1, zmm2, zmm3		; 62 f1 6d 48 f5 cb
+vpunpcklbw zmm1, zmm2, zmm3		; 62 f1 6d 48 60 cb
+vpunpckldq zmm1, zmm2, [rax]{1to16}	; 62 f1 6d 58 62 08
+vpunpckhqdq zmm1, zmm2, zmm3		; 62 f1 ed 48 6d cb
+vpmuludq zmm1, zmm2, zmm3		; 62 f1 ed 48 f4 cb
+vpacksswb zmm1, zmm2, zmm3		; 62 f1 6d 48 63 cb
+vpshufb zmm1, zmm2, zmm3		; 62 f2 6d 48 00 cb
+vpmaxsb zmm1, zmm2, zmm3		; 62 f2 6d 48 3c cb
+vpminuw zmm1, zmm2, [rax+64]		; 62 f2 6d 48 3a 48 01
+vpmaxud zmm1, zmm2, [rax]{1to16}	; 62 f2 6d 58 3f 08
+vpmuldq zmm1, zmm2, zmm3		; 62 f2 ed 48 28 cb
+vpmullw xmm1, xmm2, xmm3		; c5 e9 d5 cb
+vpbroadcastb zmm1, xmm2			; 62 f2 7d 48 78 ca
+vpbroadcastb zmm1, [rax+1]		; 62 f2 7d 48 78 48 01
+vpbroadcastw ymm1{k1}, [rax+2]		; 62 f2 7d 29 79 48 01
+vpbroadcastb zmm1, eax			; 62 f2 7d 48 7a c8
+vpbroadcastw xmm17, r8d			; 62 c2 7d 08 7b c8
+vpbroadcastd zmm1{k1}{z}, eax		; 62 f2 7d c9 7c c8
+vpbroadcastq zmm1, rax			; 62 f2 fd 48 7c c8
+vpbroadcastb xmm1, [rax]		; c4 e2 79 78 08
+vpbroadcastd ymm1, [rax]		; c4 e2 7d 58 08
+vmovss xmm1{k1}{z}, xmm2, xmm3		; 62 f1 6e 89 10 cb
+vmovss xmm17, [rax+4]			; 62 e1 7e 08 10 48 01
+vmovss [rax+8]{k1}, xmm1		; 62 f1 7e 09 11 48 02
+vmovsd xmm1, xmm2, xmm30		; 62 91 ef 08 10 ce
+vmovsd xmm1{k1}, [rax+16]		; 62 f1 ff 09 10 48 02
+vmovsd [rax], xmm17			; 62 e1 ff 08 11 08
+vmovss xmm1, [rax]			; c5 fa 10 08
+vcvtps2pd zmm1, ymm2			; 62 f1 7c 48 5a ca
+vcvtps2pd zmm1, ymm2, {sae}		; 62 f1 7c 18 5a ca
+vcvtps2pd zmm1, [rax+32]		; 62 f1 7c 48 5a 48 01
+vcvtps2pd zmm1, [rax+4]{1to8}		; 62 f1 7c 58 5a 48 01
+vcvtps2pd xmm17, xmm2			; 62 e1 7c 08 5a ca
+vcvtps2pd xmm1, [rax+8]			; c5 f8 5a 48 08
+vcvtps2pd ymm1{k1}, xmm2		; 62 f1 7c 29 5a ca
+vcvtdq2pd zmm1, ymm2			; 62 f1 7e 48 e6 ca
+vcvtdq2pd xmm1{k1}, [rax]{1to2}		; 62 f1 7e 19 e6 08
+vcvtps2pd ymm1, xmm2			; c5 fc 5a ca
+vpsllw zmm1, zmm2, xmm3			; 62 f1 6d 48 f1 cb
+vpsllw zmm1, zmm2, 3			; 62 f1 75 48 71 f2 03
+vpslld zmm1{k1}, zmm2, [rax+16]		; 62 f1 6d 49 f2 48 01
+vpslld zmm1, [rax+64], 5		; 62 f1 75 48 72 70 01 05
+vpsrlq zmm1, [rax+8]{1to8}, 5		; 62 f1 f5 58 73 50 01 05
+vpsrad zmm17, zmm2, 7			; 62 f1 75 40 72 e2 07
+vpsraq zmm1, zmm2, xmm3			; 62 f1 ed 48 e2 cb
+vpsraq xmm1, xmm2, 1			; 62 f1 f5 08 72 e2 01
+vpsrlw ymm1, ymm20, 2			; 62 b1 75 28 71 d4 02
+vpsllvd zmm1, zmm2, zmm3		; 62 f2 6d 48 47 cb
+vpsrlvq zmm1, zmm2, [rax]{1to8}		; 62 f2 ed 58 45 08
+vpsravq zmm1, zmm2, zmm3		; 62 f2 ed 48 46 cb
+vpsllvw zmm1, zmm2, zmm3		; 62 f2 ed 48 12 cb
+vpsravw ymm1, ymm2, ymm3		; 62 f2 ed 28 11 cb
+vpsrlvw zmm1, zmm2, zmm3		; 62 f2 ed 48 10 cb
+vpsllw xmm1, xmm2, 3			; c5 f1 71 f2 03
+vpermd zmm1, zmm2, zmm3			; 62 f2 6d 48 36 cb
+vpermps zmm1{k1}, zmm2, [rax]{1to16}	; 62 f2 6d 59 16 08
+vpermq zmm1, zmm2, 0x1b			; 62 f3 fd 48 00 ca 1b
+vpermq zmm1, zmm2, zmm3			; 62 f2 ed 48 36 cb
+vpermpd ymm1, ymm2, ymm3		; 62 f2 ed 28 16 cb
+vpermpd zmm1, [rax]{1to8}, 0x1b		; 62 f3 fd 58 01 08 1b
+vpermilps zmm1, zmm2, zmm3		; 62 f2 6d 48 0c cb
+vpermilps zmm1, zmm2, 0x1b		; 62 f3 7d 48 04 ca 1b
+vpermilpd zmm1, zmm2, [rax]{1to8}	; 62 f2 ed 58 0d 08
+vpermilpd zmm1, zmm2, 1			; 62 f3 fd 48 05 ca 01
+vpermi2d zmm1, zmm2, zmm3		; 62 f2 6d 48 76 cb
+vpermi2q zmm1, zmm2, zmm3		; 62 f2 ed 48 76 cb
+vpermi2ps zmm1, zmm2, zmm3		; 62 f2 6d 48 77 cb
+vpermi2pd zmm1, zmm2, zmm3		; 62 f2 ed 48 77 cb
+vpermi2w zmm1, zmm2, zmm3		; 62 f2 ed 48 75 cb
+vpermt2d zmm1, zmm2, zmm3		; 62 f2 6d 48 7e cb
+vpermt2q zmm1, zmm2, zmm3		; 62 f2 ed 48 7e cb
+vpermt2ps zmm1, zmm2, zmm3		; 62 f2 6d 48 7f cb
+vpermt2pd zmm1, zmm2, [rax]{1to8}	; 62 f2 ed 58 7f 08
+vpermt2w zmm1, zmm2, zmm3		; 62 f2 ed 48 7d cb
+vpermw zmm1, zmm2, zmm3			; 62 f2 ed 48 8d cb
+vpermq ymm1, ymm2, 0x1b			; c4 e3 fd 00 ca 1b
+vextractf32x4 xmm1, zmm2, 1		; 62 f3 7d 48 19 d1 01
+vextractf32x4 [rax+16]{k1}, zmm2, 1	; 62 f3 7d 49 19 50 01 01
+vextracti32x4 xmm1{k1}{z}, ymm2, 1	; 62 f3 7d a9 39 d1 01
+vextractf64x2 xmm1, zmm2, 3		; 62 f3 fd 48 19 d1 03
+vextracti64x2 [rax], ymm17, 1		; 62 e3 fd 28 39 08 01
+vextractf32x8 ymm1, zmm2, 1		; 62 f3 7d 48 1b d1 01
+vextracti32x8 [rax+32], zmm2, 1		; 62 f3 7d 48 3b 50 01 01
+vextractf64x4 ymm1, zmm2, 1		; 62 f3 fd 48 1b d1 01
+vextracti64x4 ymm1, zmm2, 1		; 62 f3 fd 48 3b d1 01
+vinsertf32x4 zmm1, zmm2, xmm3, 1	; 62 f3 6d 48 18 cb 01
+vinserti32x4 ymm1{k1}, ymm2, [rax+16], 1	; 62 f3 6d 29 38 48 01 01
+vinsertf64x2 zmm1, zmm2, xmm3, 2	; 62 f3 ed 48 18 cb 02
+vinserti64x2 zmm1, zmm2, [rax], 1	; 62 f3 ed 48 38 08 01
+vinsertf32x8 zmm1, zmm2, ymm3, 1	; 62 f3 6d 48 1a cb 01
+vinserti32x8 zmm1, zmm2, [rax+32], 1	; 62 f3 6d 48 3a 48 01 01
+vinsertf64x4 zmm1, zmm2, ymm3, 1	; 62 f3 ed 48 1a cb 01
+vinserti64x4 zmm1{k1}{z}, zmm2, ymm3, 1	; 62 f3 ed c9 3a cb 01
+vpgatherdd zmm1{k1}, [rax+zmm2*4]	; 62 f2 7d 49 90 0c 90
+vpgatherdd xmm1{k1}, [rax+xmm2*4+64]	; 62 f2 7d 09 90 4c 90 10
+vpgatherdq zmm1{k1}, [rax+ymm2*8]	; 62 f2 fd 49 90 0c d0
+vpgatherqd ymm1{k1}, [rax+zmm2*4]	; 62 f2 7d 49 91 0c 90
+vpgatherqd xmm1{k1}, [rax+ymm2*4]	; 62 f2 7d 29 91 0c 90
+vpgatherqq zmm1{k1}, [rax+zmm2*8]	; 62 f2 fd 49 91 0c d0
+vgatherdps zmm1{k1}, [rax+zmm18*4]	; 62 f2 7d 41 92 0c 90
+vgatherdpd zmm17{k1}, [r9+ymm22*8+8]	; 62 c2 fd 41 92 4c f1 01
+vgatherqps ymm1{k1}, [rax+zmm31*4]	; 62 b2 7d 41 93 0c b8
+vgatherqpd zmm1{k1}, [rax+zmm2]		; 62 f2 fd 49 93 0c 10
+vpscatterdd [rax+zmm2*4]{k1}, zmm1	; 62 f2 7d 49 a0 0c 90
+vpscatterdq [rax+ymm2*8]{k1}, zmm1	; 62 f2 fd 49 a0 0c d0
+vpscatterqd [rax+zmm2*4]{k1}, ymm1	; 62 f2 7d 49 a1 0c 90
+vpscatterqq [rax+zmm20*8]{k1}, zmm1	; 62 f2 fd 41 a1 0c e0
+vscatterdps [rax+zmm2*4+128]{k1}, zmm1	; 62 f2 7d 49 a2 4c 90 20
+vscatterdpd [rax+xmm2*8]{k1}, ymm1	; 62 f2 fd 29 a2 0c d0
+vscatterqps [rax+ymm2*4]{k1}, xmm1	; 62 f2 7d 29 a3 0c 90
+vscatterqpd [rax+zmm2*8]{k1}, zmm17	; 62 e2 fd 49 a3 0c d0
+vpgatherdd xmm1, [rax+xmm2*4], xmm3	; c4 e2 61 90 0c 90
+vpshufd zmm1, zmm2, 3			; 62 f1 7d 48 70 ca 03
+vpshufd xmm17{k1}{z}, [rax+16], 3	; 62 e1 7d 89 70 48 01 03
+vpshufd ymm1, [rax+4]{1to8}, 3		; 62 f1 7d 38 70 48 01 03
+vpshufhw zmm1, zmm2, 3			; 62 f1 7e 48 70 ca 03
+vpshuflw ymm17{k2}, [rax+32], 3		; 62 e1 7f 2a 70 48 01 03
+vshufps zmm1, zmm2, zmm3, 3		; 62 f1 6c 48 c6 cb 03
+vshufpd zmm1{k1}, zmm2, [rax+8]{1to8}, 3	; 62 f1 ed 59 c6 48 01 03
+vunpcklps zmm1, zmm2, zmm3		; 62 f1 6c 48 14 cb
+vunpckhps ymm17, ymm2, [rax+32]		; 62 e1 6c 28 15 48 01
+vunpcklpd zmm1, zmm2, [rax+8]{1to8}	; 62 f1 ed 58 14 48 01
+vunpckhpd xmm1{k1}{z}, xmm2, xmm3	; 62 f1 ed 89 15 cb
+vpalignr zmm1, zmm2, zmm3, 3		; 62 f3 6d 48 0f cb 03
+vpalignr xmm17{k1}, xmm2, [rax+16], 3	; 62 e3 6d 09 0f 48 01 03
+vpslldq zmm1, zmm2, 3			; 62 f1 75 48 73 fa 03
+vpslldq ymm17, [rax+32], 3		; 62 f1 75 20 73 78 01 03
+vpsrldq zmm1, zmm2, 3			; 62 f1 75 48 73 da 03
+vmovddup zmm1, zmm2			; 62 f1 ff 48 12 ca
+vmovddup xmm17, [rax+8]			; 62 e1 ff 08 12 48 01
+vmovddup ymm1{k1}, [rax+32]		; 62 f1 ff 29 12 48 01
+vmovshdup zmm1, zmm2			; 62 f1 7e 48 16 ca
+vmovsldup ymm17{k1}{z}, [rax+32]	; 62 e1 7e a9 12 48 01
+vcvtdq2ps zmm1, zmm2, {rn-sae}		; 62 f1 7c 18 5b ca
+vcvtdq2ps xmm1, [rax+4]{1to4}		; 62 f1 7c 18 5b 48 01
+vcvtps2dq zmm1{k1}, [rax+64]		; 62 f1 7d 49 5b 48 01
+vcvttps2dq zmm1, zmm2, {sae}		; 62 f1 7e 18 5b ca
+vcvtpd2ps ymm1, zmm2, {ru-sae}		; 62 f1 fd 58 5a ca
+vcvtpd2ps xmm17, ymm2			; 62 e1 fd 28 5a ca
+vcvtpd2ps xmm17, xmm2			; 62 e1 fd 08 5a ca
+vcvtpd2ps ymm1{k1}, zword [rax+64]	; 62 f1 fd 49 5a 48 01
+vcvtpd2ps xmm1, [rax+8]{1to4}		; 62 f1 fd 38 5a 48 01
+vcvtpd2dq ymm1, zmm2			; 62 f1 ff 48 e6 ca
+vcvttpd2dq ymm1, zmm2, {sae}		; 62 f1 fd 18 e6 ca
+vcvtsi2ss xmm17, xmm2, eax		; 62 e1 6e 08 2a c8
+vcvtsi2ss xmm1, xmm2, eax, {rn-sae}	; 62 f1 6e 18 2a c8
+vcvtsi2ss xmm17, xmm2, dword [rax+4]	; 62 e1 6e 08 2a 48 01
+vcvtsi2sd xmm1, xmm2, rax, {rz-sae}	; 62 f1 ef 78 2a c8
+vcvtsi2sd xmm17, xmm2, qword [rax+8]	; 62 e1 ef 08 2a 48 01
+vcvtss2sd xmm1{k1}, xmm2, xmm3, {sae}	; 62 f1 6e 19 5a cb
+vcvtss2sd xmm17, xmm2, [rax+4]		; 62 e1 6e 08 5a 48 01
+vcvtsd2ss xmm1, xmm2, xmm3, {rd-sae}	; 62 f1 ef 38 5a cb
+vcvtsd2ss xmm17, xmm2, [rax+8]		; 62 e1 ef 08 5a 48 01
+vbroadcastf32x4 zmm1, [rax+16]		; 62 f2 7d 48 1a 48 01
+vbroadcasti32x4 ymm17{k1}, [rax]	; 62 e2 7d 29 5a 08
+vbroadcastf64x2 zmm1, [rax+16]		; 62 f2 fd 48 1a 48 01
+vbroadcasti32x8 zmm1, [rax+32]		; 62 f2 7d 48 5b 48 01
+vbroadcastf64x4 zmm1{k1}{z}, [rax+32]	; 62 f2 fd c9 1b 48 01
+vbroadcasti64x4 zmm1, [rax]		; 62 f2 fd 48 5b 08
+vbroadcastf32x2 zmm1, xmm2		; 62 f2 7d 48 19 ca
+vbroadcasti32x2 xmm17, [rax+8]		; 62 e2 7d 08 59 48 01
+vshuff32x4 zmm1, zmm2, zmm3, 1		; 62 f3 6d 48 23 cb 01
+vshuff32x4 ymm1, ymm2, [rax+4]{1to8}, 1	; 62 f3 6d 38 23 48 01 01
+vshuff64x2 zmm1{k1}, zmm2, [rax+64], 1	; 62 f3 ed 49 23 48 01 01
+vshufi32x4 zmm1, zmm2, zmm3, 1		; 62 f3 6d 48 43 cb 01
+vshufi64x2 ymm17, ymm2, ymm3, 1		; 62 e3 ed 28 43 cb 01
+vpabsb zmm1, zmm2			; 62 f2 7d 48 1c ca
+vpabsw ymm17{k1}, [rax+32]		; 62 e2 7d 29 1d 48 01
+vpabsd zmm1, [rax+4]{1to16}		; 62 f2 7d 58 1e 48 01
+vpabsq zmm1{k1}{z}, zmm2		; 62 f2 fd c9 1f ca
+vpabsq xmm1, [rax+8]{1to2}		; 62 f2 fd 18 1f 48 01
+vpcmpd k1, zmm2, zmm3, 1		; 62 f3 6d 48 1f cb 01
+vpcmpd k1{k2}, ymm2, [rax+4]{1to8}, 2	; 62 f3 6d 3a 1f 48 01 02
+vpcmpud k1, zmm2, [rax+64], 1		; 62 f3 6d 48 1e 48 01 01
+vpcmpuq k1, zmm2, zmm3, 6		; 62 f3 ed 48 1e cb 06
+vpcmpb k1, zmm2, zmm3, 1		; 62 f3 6d 48 3f cb 01
+vpcmpub k1, zmm2, [rax+64], 1		; 62 f3 6d 48 3e 48 01 01
+vpcmpuw k1{k3}, xmm2, xmm3, 1		; 62 f3 ed 0b 3e cb 01
+vptestmd k1, zmm2, zmm3			; 62 f2 6d 48 27 cb
+vptestmq k1{k2}, zmm2, [rax+8]{1to8}	; 62 f2 ed 5a 27 48 01
+vptestmb k1, zmm2, zmm3			; 62 f2 6d 48 26 cb
+vptestmw k1, ymm2, [rax+32]		; 62 f2 ed 28 26 48 01
+vptestnmd k1, zmm2, zmm3		; 62 f2 6e 48 27 cb
+vptestnmb k1, zmm2, zmm3		; 62 f2 6e 48 26 cb
+vpminsq zmm1, zmm2, zmm3		; 62 f2 ed 48 39 cb
+vpminuq zmm1, zmm2, [rax+8]{1to8}	; 62 f2 ed 58 3b 48 01
+vpmaxsq ymm1{k1}, ymm2, ymm3		; 62 f2 ed 29 3d cb
+vprold zmm1, zmm2, 3			; 62 f1 75 48 72 ca 03
+vprolq zmm1{k1}, [rax+8]{1to8}, 3	; 62 f1 f5 59 72 48 01 03
+vprord ymm17, [rax+32], 3		; 62 f1 75 20 72 40 01 03
+vprorq xmm1, xmm2, 3			; 62 f1 f5 08 72 c2 03
+vprolvd zmm1, zmm2, zmm3		; 62 f2 6d 48 15 cb
+vprolvq zmm1, zmm2, [rax+8]{1to8}	; 62 f2 ed 58 15 48 01
+vprorvq xmm1{k1}, xmm2, xmm3		; 62 f2 ed 09 14 cb
+vblendmps zmm1{k1}, zmm2, zmm3		; 62 f2 6d 49 65 cb
+vblendmpd zmm1{k1}, zmm2, [rax+8]{1to8}	; 62 f2 ed 59 65 48 01
+vpblendmd zmm1{k1}, zmm2, zmm3		; 62 f2 6d 49 64 cb
+vpblendmq ymm1{k1}{z}, ymm2, ymm3	; 62 f2 ed a9 64 cb
+vpblendmb zmm1{k1}, zmm2, zmm3		; 62 f2 6d 49 66 cb
+vpblendmw zmm1{k1}, zmm2, [rax+64]	; 62 f2 ed 49 66 48 01
+vpmovzxbw zmm1, ymm2			; 62 f2 7d 48 30 ca
+vpmovzxbw zmm1{k1}, [rax+32]		; 62 f2 7d 49 30 48 01
+vpmovzxbw xmm17, [rax+8]		; 62 e2 7d 08 30 48 01
+vpmovsxbw ymm1, xmm17			; 62 b2 7d 28 20 c9
+vpmovsxdq zmm1, ymm2			; 62 f2 7d 48 25 ca
+vpmovzxdq zmm1, [rax+32]		; 62 f2 7d 48 35 48 01
+vpmovsxbd zmm1, xmm2			; 62 f2 7d 48 21 ca
+vpmovzxbd ymm17, [rax+8]		; 62 e2 7d 28 31 48 01
+vpmovsxwq zmm1, xmm2			; 62 f2 7d 48 24 ca
+vpmovsxbq zmm1, xmm2			; 62 f2 7d 48 22 ca
+vpmovsxbq zmm1, [rax+8]			; 62 f2 7d 48 22 48 01
+vpmovzxbq ymm17, [rax+4]		; 62 e2 7d 28 32 48 01
+vpmovwb ymm1, zmm2			; 62 f2 7e 48 30 d1
+vpmovwb [rax+32], zmm2			; 62 f2 7e 48 30 50 01
+vpmovswb xmm1{k1}{z}, ymm2		; 62 f2 7e a9 20 d1
+vpmovuswb [rax]{k1}, xmm2		; 62 f2 7e 09 10 10
+vpmovdb xmm1, zmm2			; 62 f2 7e 48 31 d1
+vpmovdb [rax+16], zmm2			; 62 f2 7e 48 31 50 01
+vpmovqb xmm1, zmm2			; 62 f2 7e 48 32 d1
+vpmovqb [rax+8], zmm2			; 62 f2 7e 48 32 50 01
+vpmovusqb [rax+2], xmm2			; 62 f2 7e 08 12 50 01
+vpmovdw ymm1, zmm2			; 62 f2 7e 48 33 d1
+vpmovdw [rax+32], zmm2			; 62 f2 7e 48 33 50 01
+vpmovqw xmm1, zmm2			; 62 f2 7e 48 34 d1
+vpmovqw [rax+16], zmm2			; 62 f2 7e 48 34 50 01
+vpmovusqw [rax+4], xmm2			; 62 f2 7e 08 14 50 01
+vpmovqd ymm1, zmm2			; 62 f2 7e 48 35 d1
+vpmovqd [rax+32]{k1}, zmm2		; 62 f2 7e 49 35 50 01
+vpmovusqd xmm1, xmm17			; 62 e2 7e 08 15 c9
+vpmovm2b zmm1, k1			; 62 f2 7e 48 28 c9
+vpmovm2d zmm1, k1			; 62 f2 7e 48 38 c9
+vpmovm2q xmm17, k1			; 62 e2 fe 08 38 c9
+vpmovb2m k1, zmm1			; 62 f2 7e 48 29 c9
+vpmovd2m k1, zmm1			; 62 f2 7e 48 39 c9
+vpmovq2m k1, xmm17			; 62 b2 fe 08 39 c9
+vpcompressd zmm1, zmm2			; 62 f2 7d 48 8b d1
+vpcompressd [rax+4]{k1}, zmm2		; 62 f2 7d 49 8b 50 01
+vpcompressq [rax+8], zmm2		; 62 f2 fd 48 8b 50 01
+vcompressps [rax+4], xmm17		; 62 e2 7d 08 8a 48 01
+vcompresspd [rax+64]{k1}, zmm2		; 62 f2 fd 49 8a 50 08
+vpexpandd zmm1{k1}{z}, zmm2		; 62 f2 7d c9 89 ca
+vpexpandd zmm1, [rax+4]			; 62 f2 7d 48 89 48 01
+vpexpandq ymm1{k1}, [rax+8]		; 62 f2 fd 29 89 48 01
+vexpandps zmm1, [rax+4]			; 62 f2 7d 48 88 48 01
+vexpandpd zmm1{k1}, [rax+16]		; 62 f2 fd 49 88 48 02
+vrcp14ps zmm1, zmm2			; 62 f2 7d 48 4c ca
+vrcp14ps ymm17{k1}, [rax+4]{1to8}	; 62 e2 7d 39 4c 48 01
+vrcp14ss xmm1, xmm2, xmm3		; 62 f2 6d 08 4d cb
+vrcp14sd xmm17{k1}, xmm2, [rax+8]	; 62 e2 ed 09 4d 48 01
+vrsqrt14ps zmm1{k1}{z}, zmm2		; 62 f2 7d c9 4e ca
+vrsqrt14pd xmm1, [rax+8]{1to2}		; 62 f2 fd 18 4e 48 01
+vrsqrt14ss xmm1, xmm2, [rax+4]		; 62 f2 6d 08 4f 48 01
+vgetexpps zmm1, zmm2, {sae}		; 62 f2 7d 18 42 ca
+vgetexppd ymm1, [rax+8]{1to4}		; 62 f2 fd 38 42 48 01
+vgetexpss xmm1, xmm2, xmm3, {sae}	; 62 f2 6d 18 43 cb
+vgetexpsd xmm1, xmm2, [rax+8]		; 62 f2 ed 08 43 48 01
+vscalefps zmm1, zmm2, zmm3, {rz-sae}	; 62 f2 6d 78 2c cb
+vscalefpd zmm1{k1}, zmm2, [rax+8]{1to8}	; 62 f2 ed 59 2c 48 01
+vscalefss xmm1, xmm2, xmm3, {rn-sae}	; 62 f2 6d 18 2d cb
+vscalefsd xmm17, xmm2, [rax+8]		; 62 e2 ed 08 2d 48 01
+vrndscaleps zmm1, zmm2, {sae}, 1	; 62 f3 7d 18 08 ca 01
+vrndscalepd ymm1, [rax+32], 1		; 62 f3 fd 28 09 48 01 01
+vrndscaless xmm1, xmm2, xmm3, 1		; 62 f3 6d 08 0a cb 01
+vrndscalesd xmm1, xmm2, xmm3, {sae}, 1	; 62 f3 ed 18 0b cb 01
+vrndscalesd xmm1{k1}, xmm2, [rax+8], 1	; 62 f3 ed 09 0b 48 01 01
+vgetmantps zmm1, zmm2, 1		; 62 f3 7d 48 26 ca 01
+vgetmantpd zmm1, [rax+8]{1to8}, 1	; 62 f3 fd 58 26 48 01 01
+vgetmantss xmm1, xmm2, [rax+4], 1	; 62 f3 6d 08 27 48 01 01
+vfpclassps k1, zmm2, 1			; 62 f3 7d 48 66 ca 01
+vfpclassps k1{k2}, zword [rax+64], 1	; 62 f3 7d 4a 66 48 01 01
+vfpclassps k1, [rax+4]{1to16}, 1	; 62 f3 7d 58 66 48 01 01
+vfpclassps k1, oword [rax], 1		; 62 f3 7d 08 66 08 01
+vfpclasspd k1, yword [rax+32], 1	; 62 f3 fd 28 66 48 01 01
+vfpclassss k1, xmm2, 1			; 62 f3 7d 08 67 ca 01
+vfpclassss k1, [rax+4], 1		; 62 f3 7d 08 67 48 01 01
+vfpclasssd k1{k2}, [rax+8], 1		; 62 f3 fd 0a 67 48 01 01
+vrangeps zmm1, zmm2, zmm3, 1		; 62 f3 6d 48 50 cb 01
+vrangeps zmm1, zmm2, zmm3, {sae}, 1	; 62 f3 6d 18 50 cb 01
+vrangepd ymm1{k1}, ymm2, [rax+8]{1to4}, 1	; 62 f3 ed 39 50 48 01 01
+vrangesd xmm1, xmm2, [rax+8], 1		; 62 f3 ed 08 51 48 01 01
+vreduceps zmm1, zmm2, 1			; 62 f3 7d 48 56 ca 01
+vreducepd zmm1, zmm2, {sae}, 1		; 62 f3 fd 18 56 ca 01
+vreducesd xmm1, xmm2, [rax+8], 1	; 62 f3 ed 08 57 48 01 01
+vmovd xmm17, eax			; 62 e1 7d 08 6e c8
+vmovd xmm17, [rax+4]			; 62 e1 7d 08 6e 48 01
+vmovd eax, xmm17			; 62 e1 7d 08 7e c8
+vmovd [rax+4], xmm17			; 62 e1 7d 08 7e 48 01
+vmovq xmm17, rax			; 62 e1 fd 08 6e c8
+vmovq rax, xmm17			; 62 e1 fd 08 7e c8
+vmovq xmm17, xmm2			; 62 e1 fe 08 7e ca
+vmovq xmm1, xmm17			; 62 b1 fe 08 7e c9
+vmovq xmm17, [rax+8]			; 62 e1 fd 08 6e 48 01
+vmovq [rax+8], xmm17			; 62 e1 fd 08 7e 48 01
+vpextrb eax, xmm17, 1			; 62 e3 7d 08 14 c8 01
+vpextrb [rax+1], xmm17, 1		; 62 e3 7d 08 14 48 01 01
+vpextrw eax, xmm17, 1			; 62 b1 7d 08 c5 c1 01
+vpextrw [rax+2], xmm17, 1		; 62 e3 7d 08 15 48 01 01
+vpextrd eax, xmm17, 1			; 62 e3 7d 08 16 c8 01
+vpextrd [rax+4], xmm17, 1		; 62 e3 7d 08 16 48 01 01
+vpextrq rax, xmm17, 1			; 62 e3 fd 08 16 c8 01
+vpextrq [rax+8], xmm17, 1		; 62 e3 fd 08 16 48 01 01
+vextractps eax, xmm17, 1		; 62 e3 7d 08 17 c8 01
+vextractps [rax+4], xmm17, 1		; 62 e3 7d 08 17 48 01 01
+vpinsrb xmm17, xmm2, eax, 1		; 62 e3 6d 08 20 c8 01
+vpinsrb xmm17, xmm2, [rax+1], 1		; 62 e3 6d 08 20 48 01 01
+vpinsrw xmm17, xmm2, eax, 1		; 62 e1 6d 08 c4 c8 01
+vpinsrw xmm17, xmm2, [rax+2], 1		; 62 e1 6d 08 c4 48 01 01
+vpinsrd xmm17, xmm2, eax, 1		; 62 e3 6d 08 22 c8 01
+vpinsrd xmm1, xmm18, [rax+4], 1		; 62 f3 6d 00 22 48 01 01
+vpinsrq xmm17, xmm2, rax, 1		; 62 e3 ed 08 22 c8 01
+vpinsrq xmm17, xmm2, [rax+8], 1		; 62 e3 ed 08 22 48 01 01
+vinsertps xmm17, xmm2, xmm3, 1		; 62 e3 6d 08 21 cb 01
+vinsertps xmm17, xmm2, [rax+4], 1	; 62 e3 6d 08 21 48 01 01
+vcomiss xmm17, xmm2			; 62 e1 7c 08 2f ca
+vcomiss xmm1, xmm2, {sae}		; 62 f1 7c 18 2f ca
+vcomiss xmm17, [rax+4]			; 62 e1 7c 08 2f 48 01
+vucomiss xmm1, xmm18			; 62 b1 7c 08 2e ca
+vcomisd xmm17, xmm2			; 62 e1 fd 08 2f ca
+vucomisd xmm1, xmm2, {sae}		; 62 f1 fd 18 2e ca
+vucomisd xmm17, [rax+8]			; 62 e1 fd 08 2e 48 01
+kaddb k1, k2, k3			; c5 ed 4a cb
+kaddw k1, k2, k3			; c5 ec 4a cb
+kaddd k1, k2, k3			; c4 e1 ed 4a cb
+kaddq k1, k2, k3			; c4 e1 ec 4a cb
+ktestb k1, k2				; c5 f9 99 ca
+ktestw k1, k2				; c5 f8 99 ca
+ktestd k1, k2				; c4 e1 f9 99 ca
+ktestq k1, k2				; c4 e1 f8 99 ca
+kunpckbw k1, k2, k3			; c5 ed 4b cb
+kunpckwd k1, k2, k3			; c5 ec 4b cb
+kunpckdq k1, k2, k3			; c4 e1 ec 4b cb
+kshiftrb k1, k2, 3			; c4 e3 79 30 ca 03
+kshiftrw k1, k2, 3			; c4 e3 f9 30 ca 03
+kshiftrd k1, k2, 3			; c4 e3 79 31 ca 03
+kshiftrq k1, k2, 3			; c4 e3 f9 31 ca 03
+kshiftlb k1, k2, 3			; c4 e3 79 32 ca 03
+kshiftlw k1, k2, 3			; c4 e3 f9 32 ca 03
+kshiftld k1, k2, 3			; c4 e3 79 33 ca 03
+kshiftlq k1, k2, 3			; c4 e3 f9 33 ca 03
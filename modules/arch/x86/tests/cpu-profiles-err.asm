@@ -0,0 +1,20 @@
+[bits 64]
+cpu alderlake
+vpdpbusd ymm1, ymm2, ymm3
+serialize
+movdiri [rax], ecx
+vaddps zmm0, zmm1, zmm2			; no AVX-512
+cpu icelake
+vaddps zmm0, zmm1, zmm2
+vaddps ymm16, ymm1, ymm2
+vgf2p8mulb ymm1, ymm2, ymm3
+cpu sapphirerapids
+movdiri [rax], rcx
+cpu zen3
+vaesenc ymm1, ymm2, ymm3
+vaddps ymm16, ymm1, ymm2		; missing AVX512F and AVX512VL
+cpu avx512f
+vaddps ymm16, ymm1, ymm2		; missing only AVX512VL
+cpu zen4
+vaddps ymm16, ymm1, ymm2
+vgf2p8mulb ymm1, ymm2, ymm3
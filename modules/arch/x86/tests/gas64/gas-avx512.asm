@@ -0,0 +1,9 @@
+vaddps %zmm2, %zmm1, %zmm0
+vaddps %zmm31, %zmm17, %zmm16{%k1}{z}
+vaddps 4(%rax){1to16}, %zmm2, %zmm1
+vaddps {rz-sae}, %zmm3, %zmm2, %zmm1
+vaddps 128(%rax), %zmm2, %zmm1
+vcmppd $1, {sae}, %zmm3, %zmm2, %k1
+vmovdqu32 %zmm1, 64(%rax){%k1}
+kmovw %eax, %k1
+vpternlogq $0xff, (%rax){1to8}, %zmm2, %zmm1
@@ -0,0 +1,11 @@
+; --insn-stats counts each TIMES copy
+bits 64
+times 4 nop
+times 3 add rax, [rbx+8]
+times 2 vpaddd xmm1, xmm2, xmm3
+lock inc dword [rax]
+mov ax, 1
+vaddps zmm1, zmm2, zmm3
+times 2 jmp short next
+next:
+jmp far [rax]
@@ -0,0 +1,3 @@
+#! /bin/sh
+${srcdir}/text_test.sh x86_insnstats_test modules/arch/x86/tests/insnstats "x86 instruction statistics" "--insn-stats=table -f bin" ".stats"
+exit $?
@@ -0,0 +1,5 @@
+[bits 64]
+movdiri [rax], ecx			; 0f 38 f9 08
+movdiri [rax+8], r9			; 4c 0f 38 f9 48 08
+movdiri qword [rax], rcx		; 48 0f 38 f9 08
+serialize				; 0f 01 e8
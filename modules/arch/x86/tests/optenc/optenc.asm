@@ -0,0 +1,28 @@
+; shortened with --optimize-encoding
+bits 64
+mov rax, 5
+mov rcx, 0x80000000
+mov r9, 0xffffffff
+mov r8, 1
+mov rax, -1		; not zero extended
+mov rax, 0x100000000
+mov rax, qword 5
+mov rax, strict qword 5
+mov rax, label		; not a constant
+xor rax, rax
+sub rbx, rbx
+xor r8, r8		; needs REX anyway
+xor rax, rbx
+and rax, 0xff
+and rax, 0x7fffffff
+and rax, -2		; sign bit set
+test rdx, 0x40
+test rax, 1
+cmp rax, 5		; flags differ
+vandps xmm0, xmm1, xmm8
+vorpd ymm2, ymm9
+vaddps xmm0, xmm1, xmm8	; NaN result depends on the order
+vaddss xmm0, xmm1, xmm8	; scalar: not commutative
+vpxor xmm3, xmm4, xmm12
+vsubps xmm0, xmm1, xmm8	; not commutative
+label:
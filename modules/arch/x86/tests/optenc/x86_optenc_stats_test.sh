@@ -0,0 +1,33 @@
+#! /bin/sh
+# Check that the "encoding bytes saved" count printed by --stats matches the
+# difference in output size made by --optimize-encoding.
+
+YASM_TEST_SUITE=1
+export YASM_TEST_SUITE
+
+case `echo "testing\c"; echo 1,2,3`,`echo -n testing; echo 1,2,3` in
+  *c*,-n*) ECHO_N= ECHO_C='
+' ECHO_T='	' ;;
+  *c*,*  ) ECHO_N=-n ECHO_C= ECHO_T= ;;
+  *)       ECHO_N= ECHO_C='\c' ECHO_T= ;;
+esac
+
+mkdir results >/dev/null 2>&1
+
+asm=${srcdir}/modules/arch/x86/tests/optenc/optenc.asm
+
+echo $ECHO_N "Test x86_optenc_stats_test: $ECHO_C"
+./yasm -f bin -o results/optenc-plain.bin ${asm} >/dev/null 2>&1
+./yasm --optimize-encoding --stats -f bin -o results/optenc-opt.bin ${asm} \
+    2>results/optenc-stats.txt >/dev/null
+plain=`wc -c < results/optenc-plain.bin`
+opt=`wc -c < results/optenc-opt.bin`
+saved=`sed -n 's/^ *encoding bytes saved *//p' results/optenc-stats.txt`
+
+if test "x${saved}" != x && test `expr ${plain} - ${opt}` -eq "${saved}"; then
+    echo ". +1-0/1 100%"
+    exit 0
+fi
+echo "F +0-1/1 0%"
+echo " ** F: optenc saved ${saved} bytes, output shrank by `expr ${plain} - ${opt}`"
+exit 1
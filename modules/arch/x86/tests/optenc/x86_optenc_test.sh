@@ -0,0 +1,3 @@
+#! /bin/sh
+${srcdir}/out_test.sh x86_optenc_test modules/arch/x86/tests/optenc "x86 encoding optimization" "--optimize-encoding -f bin" ""
+exit $?
@@ -0,0 +1,8 @@
+[bits 64]
+cpu nogfni
+vgf2p8mulb xmm1, xmm2, xmm3
+cpu gfni
+vgf2p8mulb xmm1, xmm2, xmm3
+cpu novaes
+vaesenc ymm1, ymm2, ymm3
+vaesenc xmm1, xmm2, xmm3
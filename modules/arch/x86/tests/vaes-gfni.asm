@@ -0,0 +1,31 @@
+; VAES, VPCLMULQDQ, GFNI, AVX-VNNI, and AVX-IFMA instructions
+
+[bits 64]
+
+vaesenc ymm1, ymm2, ymm3		; c4 e2 6d dc cb
+vaesenc ymm1, ymm2, [rax]		; c4 e2 6d dc 08
+vaesenclast ymm1, ymm2, ymm3		; c4 e2 6d dd cb
+vaesdec ymm1, ymm2, ymm3		; c4 e2 6d de cb
+vaesdeclast ymm9, ymm10, [r11]		; c4 42 2d df 0b
+vaesenc xmm1, xmm2, xmm3		; c4 e2 69 dc cb
+vpclmulqdq ymm1, ymm2, ymm3, 0x11	; c4 e3 6d 44 cb 11
+vpclmulqdq ymm1, ymm2, [rax], 0		; c4 e3 6d 44 08 00
+vpclmullqhqdq ymm1, ymm2, ymm3		; c4 e3 6d 44 cb 10
+vpclmulhqhqdq ymm1, ymm2, [rax]		; c4 e3 6d 44 08 11
+gf2p8mulb xmm1, xmm2			; 66 0f 38 cf ca
+gf2p8mulb xmm1, [rax]			; 66 0f 38 cf 08
+gf2p8affineqb xmm1, xmm2, 5		; 66 0f 3a ce ca 05
+gf2p8affineinvqb xmm1, [rax], 5		; 66 0f 3a cf 08 05
+vgf2p8mulb xmm1, xmm2, xmm3		; c4 e2 69 cf cb
+vgf2p8mulb ymm1, ymm2, [rax]		; c4 e2 6d cf 08
+vgf2p8affineqb xmm1, xmm2, xmm3, 1	; c4 e3 e9 ce cb 01
+vgf2p8affineqb ymm1, ymm2, ymm3, 1	; c4 e3 ed ce cb 01
+vgf2p8affineinvqb ymm1, ymm2, [rax], 0xff	; c4 e3 ed cf 08 ff
+vpdpbusd xmm1, xmm2, xmm3		; c4 e2 69 50 cb
+vpdpbusd ymm1, ymm2, [rax]		; c4 e2 6d 50 08
+vpdpbusds ymm1, ymm2, ymm3		; c4 e2 6d 51 cb
+vpdpwssd ymm1, ymm2, ymm3		; c4 e2 6d 52 cb
+vpdpwssds ymm8, ymm9, ymm10		; c4 42 35 53 c2
+vpmadd52luq xmm1, xmm2, xmm3		; c4 e2 e9 b4 cb
+vpmadd52luq ymm1, ymm2, [rax]		; c4 e2 ed b4 08
+vpmadd52huq ymm1, ymm2, ymm3		; c4 e2 ed b5 cb
@@ -66,7 +66,7 @@ x86_create(const char *machine, const char *parser,
     arch_x86->active_cpu = 0;
     arch_x86->cpu_enables_size = 1;
     arch_x86->cpu_enables = yasm_xmalloc(sizeof(wordptr));
-    arch_x86->cpu_enables[0] = BitVector_Create(64, FALSE);
+    arch_x86->cpu_enables[0] = BitVector_Create(128, FALSE);
     BitVector_Fill(arch_x86->cpu_enables[0]);
 
     arch_x86->amd64_machine = amd64_machine;
@@ -74,6 +74,12 @@ x86_create(const char *machine, const char *parser,
     arch_x86->address_size = address_size;
     arch_x86->force_strict = 0;
     arch_x86->default_rel = 0;
+    arch_x86->align_branches = 0;
+    arch_x86->align_loops = 0;
+    arch_x86->align_loops_max_skip = 0;
+    arch_x86->optimize_encoding = 0;
+    arch_x86->encoding_saved = 0;
+    arch_x86->insn_stats = NULL;
     arch_x86->gas_intel_mode = 0;
     arch_x86->nop = X86_NOP_BASIC;
 
@@ -101,6 +107,10 @@ x86_destroy(/*@only@*/ yasm_arch *arch)
     for (i=0; i<arch_x86->cpu_enables_size; i++)
         BitVector_Destroy(arch_x86->cpu_enables[i]);
     yasm_xfree(arch_x86->cpu_enables);
+    if (arch_x86->insn_stats) {
+        HAMT_destroy(arch_x86->insn_stats->mnemonics, yasm_xfree);
+        yasm_xfree(arch_x86->insn_stats);
+    }
     yasm_xfree(arch);
 }
 
@@ -142,11 +152,146 @@ x86_set_var(yasm_arch *arch, const char *var, unsigned long val)
             arch_x86->default_rel = (unsigned int)val;
     } else if (yasm__strcasecmp(var, "gas_intel_mode") == 0) {
         arch_x86->gas_intel_mode = (unsigned int)val;
+    } else if (yasm__strcasecmp(var, "align_branches") == 0) {
+        arch_x86->align_branches = val;
+    } else if (yasm__strcasecmp(var, "align_loops") == 0) {
+        arch_x86->align_loops = (unsigned int)val;
+    } else if (yasm__strcasecmp(var, "align_loops_max_skip") == 0) {
+        arch_x86->align_loops_max_skip = (unsigned int)val;
+    } else if (yasm__strcasecmp(var, "optimize_encoding") == 0) {
+        arch_x86->optimize_encoding = (unsigned int)val;
+    } else if (yasm__strcasecmp(var, "insn_stats") == 0) {
+        if (val && !arch_x86->insn_stats) {
+            arch_x86->insn_stats = yasm_xcalloc(1, sizeof(x86_insn_stats));
+            arch_x86->insn_stats->mnemonics =
+                HAMT_create(0, yasm_internal_error_);
+        }
     } else
         return 1;
     return 0;
 }
 
+static int
+x86_count_section_stats(yasm_section *sect, /*@null@*/ void *d)
+{
+    yasm_bytecode *bc;
+
+    for (bc = yasm_section_bcs_first(sect); bc; bc = yasm_bc__next(bc))
+        yasm_x86__bc_count_stats(bc, (x86_insn_stats *)d);
+    return 0;
+}
+
+static int
+x86_mnemonic_count_compare(const void *a, const void *b)
+{
+    const x86_mnemonic_count *ma = *(const x86_mnemonic_count * const *)a;
+    const x86_mnemonic_count *mb = *(const x86_mnemonic_count * const *)b;
+
+    if (ma->count != mb->count)
+        return ma->count > mb->count ? -1 : 1;
+    return strcmp(ma->name, mb->name);
+}
+
+static void
+x86_print_insn_stats(yasm_arch *arch, yasm_object *object, FILE *f, int json)
+{
+    yasm_arch_x86 *arch_x86 = (yasm_arch_x86 *)arch;
+    x86_insn_stats *stats = arch_x86->insn_stats;
+    const HAMTEntry *entry;
+    x86_mnemonic_count **mnemonics;
+    size_t num_mnemonics = 0, i;
+    unsigned long jumps;
+    static const char *sizes[] = {"0", "8", "16", "32", "64"};
+    const char *sep;
+
+    if (!stats)
+        return;
+
+    /* Encoding details are only final after optimization; count them now */
+    yasm_object_sections_traverse(object, stats, x86_count_section_stats);
+    jumps = stats->jmp_short + stats->jmp_near;
+
+    /* Sort mnemonics by decreasing count */
+    for (entry = HAMT_first(stats->mnemonics); entry;
+         entry = HAMT_next(entry))
+        num_mnemonics++;
+    mnemonics = yasm_xmalloc((num_mnemonics+1)*sizeof(x86_mnemonic_count *));
+    for (i = 0, entry = HAMT_first(stats->mnemonics); entry;
+         entry = HAMT_next(entry))
+        mnemonics[i++] = HAMTEntry_get_data(entry);
+    qsort(mnemonics, num_mnemonics, sizeof(x86_mnemonic_count *),
+          x86_mnemonic_count_compare);
+
+    if (json) {
+        fprintf(f, "{\n  \"instructions\": %lu,\n  \"bytes\": %lu,\n",
+                stats->insns, stats->bytes);
+        fprintf(f, "  \"mnemonics\": {");
+        for (i = 0, sep = ""; i < num_mnemonics; i++, sep = ",")
+            fprintf(f, "%s\n    \"%s\": %lu", sep, mnemonics[i]->name,
+                    mnemonics[i]->count);
+        fprintf(f, "\n  },\n");
+        fprintf(f, "  \"prefixes\": {\"rex\": %lu, \"vex2\": %lu, "
+                "\"vex3\": %lu, \"xop\": %lu, \"evex\": %lu, "
+                "\"opersize\": %lu, \"addrsize\": %lu, \"lockrep\": %lu},\n",
+                stats->rex, stats->vex2, stats->vex3, stats->xop, stats->evex,
+                stats->opersize, stats->addrsize, stats->lockrep);
+        fprintf(f, "  \"displacement\": {");
+        for (i = 0; i < NELEMS(stats->disp); i++)
+            fprintf(f, "%s\"%s\": %lu", i ? ", " : "", sizes[i],
+                    stats->disp[i]);
+        fprintf(f, "},\n  \"immediate\": {");
+        for (i = 0; i < NELEMS(stats->imm); i++)
+            fprintf(f, "%s\"%s\": %lu", i ? ", " : "", sizes[i+1],
+                    stats->imm[i]);
+        fprintf(f, "},\n  \"jumps\": {\"short\": %lu, \"near\": %lu, "
+                "\"far\": %lu, \"short_ratio\": %.3f}\n}\n",
+                stats->jmp_short, stats->jmp_near, stats->jmp_far,
+                jumps ? (double)stats->jmp_short/jumps : 0.0);
+    } else {
+        fprintf(f, "%-24s %10lu (%lu bytes)\n", "instructions", stats->insns,
+                stats->bytes);
+        fprintf(f, "mnemonics:\n");
+        for (i = 0; i < num_mnemonics; i++)
+            fprintf(f, "  %-22s %10lu\n", mnemonics[i]->name,
+                    mnemonics[i]->count);
+        fprintf(f, "prefixes:\n");
+        fprintf(f, "  %-22s %10lu\n", "rex", stats->rex);
+        fprintf(f, "  %-22s %10lu\n", "vex2", stats->vex2);
+        fprintf(f, "  %-22s %10lu\n", "vex3", stats->vex3);
+        fprintf(f, "  %-22s %10lu\n", "xop", stats->xop);
+        fprintf(f, "  %-22s %10lu\n", "evex", stats->evex);
+        fprintf(f, "  %-22s %10lu\n", "operand size", stats->opersize);
+        fprintf(f, "  %-22s %10lu\n", "address size", stats->addrsize);
+        fprintf(f, "  %-22s %10lu\n", "lock/rep", stats->lockrep);
+        fprintf(f, "displacement bits:\n");
+        for (i = 0; i < NELEMS(stats->disp); i++)
+            fprintf(f, "  %-22s %10lu\n", sizes[i], stats->disp[i]);
+        fprintf(f, "immediate bits:\n");
+        for (i = 0; i < NELEMS(stats->imm); i++)
+            fprintf(f, "  %-22s %10lu\n", sizes[i+1], stats->imm[i]);
+        fprintf(f, "jumps:\n");
+        fprintf(f, "  %-22s %10lu\n", "short", stats->jmp_short);
+        fprintf(f, "  %-22s %10lu\n", "near", stats->jmp_near);
+        fprintf(f, "  %-22s %10lu\n", "far", stats->jmp_far);
+        if (jumps)
+            fprintf(f, "  %-22s %9.1f%%\n", "short ratio",
+                    100.0*stats->jmp_short/jumps);
+    }
+
+    yasm_xfree(mnemonics);
+}
+
+static int
+x86_get_var(const yasm_arch *arch, const char *var, unsigned long *val)
+{
+    const yasm_arch_x86 *arch_x86 = (const yasm_arch_x86 *)arch;
+    if (yasm__strcasecmp(var, "encoding_saved") == 0)
+        *val = arch_x86->encoding_saved;
+    else
+        return 1;
+    return 0;
+}
+
 static void
 x86_dir_cpu(yasm_object *object, yasm_valparamhead *valparams,
             yasm_valparamhead *objext_valparams, unsigned long line)
@@ -459,7 +604,7 @@ x86_get_fill(const yasm_arch *arch)
 unsigned int
 yasm_x86__get_reg_size(uintptr_t reg)
 {
-    switch ((x86_expritem_reg_size)(reg & ~0xFUL)) {
+    switch ((x86_expritem_reg_size)(reg & ~(0xFUL|X86_REG_HI))) {
         case X86_REG8:
         case X86_REG8X:
             return 8;
@@ -472,11 +617,14 @@ yasm_x86__get_reg_size(uintptr_t reg)
             return 32;
         case X86_REG64:
         case X86_MMXREG:
+        case X86_KREG:
             return 64;
         case X86_XMMREG:
             return 128;
         case X86_YMMREG:
             return 256;
+        case X86_ZMMREG:
+            return 512;
         case X86_FPUREG:
             return 80;
         default:
@@ -499,10 +647,12 @@ x86_reggroup_get_reg(yasm_arch *arch, uintptr_t reggroup,
     switch ((x86_expritem_reg_size)(reggroup & ~0xFUL)) {
         case X86_XMMREG:
         case X86_YMMREG:
+        case X86_ZMMREG:
             if (arch_x86->mode_bits == 64) {
-                if (regindex > 15)
+                if (regindex > 31)
                     return 0;
-                return reggroup | (regindex & 15);
+                return reggroup | (regindex & 15) |
+                    ((regindex & 16) ? X86_REG_HI : 0);
             }
             /*@fallthrough@*/
         case X86_MMXREG:
@@ -537,7 +687,7 @@ x86_reg_print(yasm_arch *arch, uintptr_t reg, FILE *f)
         "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15"
     };
 
-    switch ((x86_expritem_reg_size)(reg & ~0xFUL)) {
+    switch ((x86_expritem_reg_size)(reg & ~(0xFUL|X86_REG_HI))) {
         case X86_REG8:
             fprintf(f, "%s", name8[reg&0xF]);
             break;
@@ -557,10 +707,16 @@ x86_reg_print(yasm_arch *arch, uintptr_t reg, FILE *f)
             fprintf(f, "mm%d", (int)(reg&0xF));
             break;
         case X86_XMMREG:
-            fprintf(f, "xmm%d", (int)(reg&0xF));
+            fprintf(f, "xmm%d", (int)(reg&0xF) + ((reg&X86_REG_HI) ? 16:0));
             break;
         case X86_YMMREG:
-            fprintf(f, "ymm%d", (int)(reg&0xF));
+            fprintf(f, "ymm%d", (int)(reg&0xF) + ((reg&X86_REG_HI) ? 16:0));
+            break;
+        case X86_ZMMREG:
+            fprintf(f, "zmm%d", (int)(reg&0xF) + ((reg&X86_REG_HI) ? 16:0));
+            break;
+        case X86_KREG:
+            fprintf(f, "k%d", (int)(reg&0xF));
             break;
         case X86_CRREG:
             fprintf(f, "cr%d", (int)(reg&0xF));
@@ -613,6 +769,8 @@ yasm_arch_module yasm_x86_LTX_arch = {
     x86_get_machine,
     x86_get_address_size,
     x86_set_var,
+    x86_get_var,
+    x86_print_insn_stats,
     yasm_x86__parse_check_insnprefix,
     yasm_x86__parse_check_regtmod,
     x86_get_fill,
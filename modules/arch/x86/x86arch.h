@@ -90,6 +90,18 @@
 #define CPU_RDSEED  56      /* Intel RDSEED instruction */
 #define CPU_ADX     57      /* Intel ADCX and ADOX instructions */
 #define CPU_PRFCHW  58      /* Intel/AMD PREFETCHW instruction */
+#define CPU_AVX512F 59      /* Intel AVX-512 Foundation */
+#define CPU_AVX512CD 60     /* Intel AVX-512 Conflict Detection */
+#define CPU_AVX512BW 61     /* Intel AVX-512 Byte and Word */
+#define CPU_AVX512DQ 62     /* Intel AVX-512 Doubleword and Quadword */
+#define CPU_AVX512VL 63     /* Intel AVX-512 Vector Length extensions */
+#define CPU_VAES    64      /* Intel 256-bit AES instructions */
+#define CPU_VPCLMULQDQ 65   /* Intel 256-bit PCLMULQDQ instruction */
+#define CPU_GFNI    66      /* Intel Galois Field instructions */
+#define CPU_AVXVNNI 67      /* Intel AVX (VEX) VNNI instructions */
+#define CPU_AVXIFMA 68      /* Intel AVX (VEX) IFMA instructions */
+#define CPU_MOVDIRI 69      /* Intel MOVDIRI instruction */
+#define CPU_SERIALIZE 70    /* Intel SERIALIZE instruction */
 
 enum x86_parser_type {
     X86_PARSER_NASM = 0,
@@ -115,6 +127,22 @@ typedef struct yasm_arch_x86 {
     unsigned int default_rel;
     unsigned int gas_intel_mode;
 
+    /* Boundary branches must not cross or end on, 0 if no branch padding */
+    unsigned long align_branches;
+
+    /* Loop head alignment boundary (0 if none) and maximum skip */
+    unsigned int align_loops;
+    unsigned int align_loops_max_skip;
+
+    /* Shortest-encoding optimization level (0 if off), and the number of
+     * bytes it has saved so far.
+     */
+    unsigned int optimize_encoding;
+    unsigned long encoding_saved;
+
+    /* Instruction statistics (NULL if not gathering) */
+    /*@null@*/ /*@only@*/ struct x86_insn_stats *insn_stats;
+
     enum {
         X86_NOP_BASIC = 0,
         X86_NOP_INTEL = 1,
@@ -124,6 +152,8 @@ typedef struct yasm_arch_x86 {
 
 /* 0-15 (low 4 bits) used for register number, stored in same data area.
  * Note 8-15 are only valid for some registers, and only in 64-bit mode.
+ * The EVEX-only registers 16-31 (XMM/YMM/ZMM) additionally set X86_REG_HI,
+ * so code that switches on the register size rejects them by default.
  */
 typedef enum {
     X86_REG8 = 0x1<<4,
@@ -138,9 +168,13 @@ typedef enum {
     X86_CRREG = 0xA<<4,
     X86_DRREG = 0xB<<4,
     X86_TRREG = 0xC<<4,
-    X86_RIP = 0xD<<4        /* 64-bit mode only, always RIP (regnum ignored) */
+    X86_RIP = 0xD<<4,       /* 64-bit mode only, always RIP (regnum ignored) */
+    X86_ZMMREG = 0xE<<4,
+    X86_KREG = 0xF<<4       /* AVX-512 opmask registers */
 } x86_expritem_reg_size;
 
+#define X86_REG_HI  0x100   /* register number 16-31 (EVEX only) */
+
 /* Low 8 bits are used for the prefix value, stored in same data area. */
 typedef enum {
     X86_LOCKREP = 1<<8,
@@ -187,7 +221,7 @@ typedef struct x86_effaddr {
     yasm_effaddr ea;            /* base structure */
 
     /* VSIB uses the normal SIB byte, but this flag enables it. */
-    unsigned char vsib_mode;    /* 0 if not, 1 if XMM, 2 if YMM */
+    unsigned char vsib_mode;    /* 0 if not, 1 if XMM, 2 if YMM, 3 if ZMM */
 
     /* How the spare (register) bits in Mod/RM are handled:
      * Even if valid_modrm=0, the spare bits are still valid (don't overwrite!)
@@ -201,6 +235,9 @@ typedef struct x86_effaddr {
     unsigned char valid_sib;    /* 1 if SIB byte currently valid, 0 if not */
     unsigned char need_sib;     /* 1 if SIB byte needed, 0 if not,
                                    0xff if unknown */
+
+    /* EVEX compressed displacement scale (disp8*N); 0 or 1 if unscaled. */
+    unsigned char disp8_n;
 } x86_effaddr;
 
 void yasm_x86__ea_init(x86_effaddr *x86_ea, unsigned int spare,
@@ -235,7 +272,7 @@ typedef struct x86_common {
 } x86_common;
 
 typedef struct x86_opcode {
-    unsigned char opcode[3];        /* opcode */
+    unsigned char opcode[4];        /* opcode (EVEX needs 3 + 1 bytes) */
     unsigned char len;
 } x86_opcode;
 
@@ -296,6 +333,26 @@ typedef struct x86_jmpfar {
     yasm_value offset;          /* target offset */
 } x86_jmpfar;
 
+/* Instruction encoding statistics */
+typedef struct x86_insn_stats {
+    /*@only@*/ HAMT *mnemonics;     /* x86_mnemonic_count, by mnemonic */
+    unsigned long insns;            /* instructions, counting TIMES copies */
+    unsigned long bytes;            /* total instruction length */
+    unsigned long rex, vex2, vex3, xop, evex;
+    unsigned long opersize, addrsize, lockrep;  /* legacy prefixes */
+    unsigned long disp[5];          /* none, 8, 16, 32, 64-bit displacement */
+    unsigned long imm[4];           /* 8, 16, 32, 64-bit immediate */
+    unsigned long jmp_short, jmp_near, jmp_far;
+} x86_insn_stats;
+
+typedef struct x86_mnemonic_count {
+    /*@observer@*/ const char *name;
+    unsigned long count;
+} x86_mnemonic_count;
+
+void yasm_x86__bc_count_stats(const yasm_bytecode *bc,
+                              x86_insn_stats *stats);
+
 void yasm_x86__bc_transform_insn(yasm_bytecode *bc, x86_insn *insn);
 void yasm_x86__bc_transform_jmp(yasm_bytecode *bc, x86_jmp *jmp);
 void yasm_x86__bc_transform_jmpfar(yasm_bytecode *bc, x86_jmpfar *jmpfar);
@@ -156,6 +156,96 @@ yasm_x86__bc_transform_jmpfar(yasm_bytecode *bc, x86_jmpfar *jmpfar)
     yasm_bc_transform(bc, &x86_bc_callback_jmpfar, jmpfar);
 }
 
+/* Index of a 0, 8, 16, 32, or 64-bit size in the statistics arrays */
+static unsigned int
+x86_stats_size_index(unsigned int size)
+{
+    switch (size) {
+        case 0:
+            return 0;
+        case 8:
+            return 1;
+        case 16:
+            return 2;
+        case 32:
+            return 3;
+        default:
+            return 4;
+    }
+}
+
+/* Count the legacy prefixes x86_common_calc_len() makes room for. */
+static void
+x86_common_count_stats(const x86_common *common, x86_insn_stats *stats,
+                       unsigned long n)
+{
+    if (common->addrsize != 0 && common->addrsize != common->mode_bits)
+        stats->addrsize += n;
+    if (common->opersize != 0 &&
+        ((common->mode_bits != 64 && common->opersize != common->mode_bits) ||
+         (common->mode_bits == 64 && common->opersize == 16)))
+        stats->opersize += n;
+    if (common->lockrep_pre != 0)
+        stats->lockrep += n;
+}
+
+void
+yasm_x86__bc_count_stats(const yasm_bytecode *bc, x86_insn_stats *stats)
+{
+    /* Each copy of a TIMES repeated instruction counts, as in the output */
+    unsigned long n = bc->mult_int > 0 ? (unsigned long)bc->mult_int : 0;
+
+    if (bc->callback == &x86_bc_callback_insn) {
+        const x86_insn *insn = (const x86_insn *)bc->contents;
+        const x86_effaddr *x86_ea = insn->x86_ea;
+
+        x86_common_count_stats(&insn->common, stats, n);
+        switch (insn->special_prefix) {
+            case 0xC5:
+                stats->vex2 += n;
+                break;
+            case 0xC4:
+                stats->vex3 += n;
+                break;
+            case 0x8F:
+                stats->xop += n;
+                break;
+            case 0x62:
+                stats->evex += n;
+                break;
+            default:
+                if (insn->rex != 0 && insn->rex != 0xff)
+                    stats->rex += n;
+                break;
+        }
+
+        /* Only memory operands have a displacement */
+        if (x86_ea &&
+            !(x86_ea->need_modrm && (x86_ea->modrm & 0xC0) == 0xC0))
+            stats->disp[x86_stats_size_index(x86_ea->ea.disp.size)] += n;
+
+        if (insn->imm && insn->imm->size > 0)
+            stats->imm[x86_stats_size_index(insn->imm->size)-1] += n;
+    } else if (bc->callback == &x86_bc_callback_jmp) {
+        const x86_jmp *jmp = (const x86_jmp *)bc->contents;
+
+        x86_common_count_stats(&jmp->common, stats, n);
+        if (jmp->op_sel == JMP_SHORT || jmp->op_sel == JMP_SHORT_FORCED)
+            stats->jmp_short += n;
+        else
+            stats->jmp_near += n;
+    } else if (bc->callback == &x86_bc_callback_jmpfar) {
+        const x86_jmpfar *jmpfar = (const x86_jmpfar *)bc->contents;
+
+        x86_common_count_stats(&jmpfar->common, stats, n);
+        stats->jmp_far += n;
+    } else
+        return;
+
+    stats->insns += n;
+    stats->bytes += yasm_bc_next_offset((yasm_bytecode *)bc) - bc->offset;
+}
+
 void
 yasm_x86__ea_init(x86_effaddr *x86_ea, unsigned int spare,
                   yasm_bytecode *precbc)
@@ -197,6 +287,7 @@ ea_create(void)
     x86_ea->sib = 0;
     x86_ea->valid_sib = 0;
     x86_ea->need_sib = 0;
+    x86_ea->disp8_n = 0;
 
     return x86_ea;
 }
@@ -619,7 +710,8 @@ x86_bc_insn_calc_len(yasm_bytecode *bc, yasm_bc_add_span_func add_span,
         bc->len += immlen/8;
     }
 
-    /* VEX and XOP prefixes never have REX (it's embedded in the opcode).
+    /* VEX, XOP, and EVEX prefixes never have REX (it's embedded in the
+     * opcode).
      * For VEX, we can come into this function with the three byte form,
      * so we need to see if we can optimize to the two byte form.
      * We can't do it earlier, as we don't know all of the REX byte until now.
@@ -639,7 +731,8 @@ x86_bc_insn_calc_len(yasm_bytecode *bc, yasm_bc_add_span_func add_span,
             insn->special_prefix = 0xC5;    /* mark as two-byte VEX */
         }
     } else if (insn->rex != 0xff && insn->rex != 0 &&
-               insn->special_prefix != 0xC5 && insn->special_prefix != 0x8F)
+               insn->special_prefix != 0xC5 && insn->special_prefix != 0x8F &&
+               insn->special_prefix != 0x62)
         bc->len++;
 
     bc->len += insn->opcode.len;
@@ -725,8 +818,10 @@ x86_bc_jmp_calc_len(yasm_bytecode *bc, yasm_bc_add_span_func add_span,
 
     if (jmp->target.rel
         && (!yasm_symrec_get_label(jmp->target.rel, &target_prevbc)
-            || target_prevbc->section != bc->section)) {
-        /* External or out of segment, so we can't check distance.
+            || !yasm_section_is_layout_linked(target_prevbc->section,
+                                              bc->section))) {
+        /* External or out of segment (and not in a section at a known
+         * distance in the output), so we can't check distance.
          * Allowing short jumps depends on the objfmt supporting
          * 8-bit relocs.  While most don't, some might, so allow it here.
          * Otherwise default to word-sized.
@@ -844,8 +939,11 @@ x86_bc_insn_tobytes(yasm_bytecode *bc, unsigned char **bufp,
                        x86_ea ? (unsigned int)(x86_ea->ea.segreg>>8) : 0);
     if (insn->special_prefix != 0)
         YASM_WRITE_8(*bufp, insn->special_prefix);
-    if (insn->special_prefix == 0xC4 || insn->special_prefix == 0x8F) {
-        /* 3-byte VEX/XOP; merge in 1s complement of REX.R, REX.X, REX.B */
+    if (insn->special_prefix == 0xC4 || insn->special_prefix == 0x8F ||
+        insn->special_prefix == 0x62) {
+        /* 3-byte VEX/XOP or EVEX; merge in 1s complement of REX.R, REX.X,
+         * REX.B.  EVEX keeps its R' bit (bit 4) in the same byte.
+         */
         insn->opcode.opcode[0] &= 0x1F;
         if (insn->rex != 0xff)
             insn->opcode.opcode[0] |= ((~insn->rex) & 0x07) << 5;
@@ -46,8 +46,18 @@ x86_expr_checkea_get_reg3264(yasm_expr__item *ei, int *regnum,
                              /*returned*/ void *d)
 {
     x86_checkea_reg3264_data *data = d;
+    int hi = 0;
 
-    switch ((x86_expritem_reg_size)(ei->data.reg & ~0xFUL)) {
+    /* Registers 16-31 can only be a VSIB index (the insn has already
+     * checked it's an EVEX form).
+     */
+    if (data->vsib_mode != 0 && (ei->data.reg & X86_REG_HI)) {
+        if (data->bits != 64)
+            return 0;
+        hi = 16;
+    }
+
+    switch ((x86_expritem_reg_size)(ei->data.reg & ~(0xFUL|X86_REG_HI))) {
         case X86_REG32:
             if (data->addrsize != 32)
                 return 0;
@@ -72,6 +82,13 @@ x86_expr_checkea_get_reg3264(yasm_expr__item *ei, int *regnum,
                 return 0;
             *regnum = 17+(unsigned int)(ei->data.reg & 0xF);
             break;
+        case X86_ZMMREG:
+            if (data->vsib_mode != 3)
+                return 0;
+            if (data->bits != 64 && (ei->data.reg & 0x8) == 0x8)
+                return 0;
+            *regnum = 17+(unsigned int)(ei->data.reg & 0xF);
+            break;
         case X86_RIP:
             if (data->bits != 64)
                 return 0;
@@ -80,6 +97,7 @@ x86_expr_checkea_get_reg3264(yasm_expr__item *ei, int *regnum,
         default:
             return 0;
     }
+    *regnum += hi;
 
     /* overwrite with 0 to eliminate register from displacement expr */
     ei->type = YASM_EXPR_INT;
@@ -432,6 +450,8 @@ x86_expr_checkea_getregusage(yasm_expr **ep, /*@null@*/ int *indexreg,
  *  wordsize=16 for 16-bit, =32 for 32-bit.
  *  noreg=1 if the *ModRM byte* has no registers used.
  *  dispreq=1 if a displacement value is *required* (even if =0).
+ * For EVEX instructions (disp8_n > 1), a byte displacement is scaled by
+ * disp8_n, so only multiples of it can use the short form.
  * Returns 0 if successfully calculated, 1 if not.
  */
 /*@-nullstate@*/
@@ -440,9 +460,16 @@ x86_checkea_calc_displen(x86_effaddr *x86_ea, unsigned int wordsize, int noreg,
                          int dispreq)
 {
     /*@null@*/ /*@only@*/ yasm_intnum *num;
+    unsigned int scale = x86_ea->disp8_n > 1 ? x86_ea->disp8_n : 1;
 
     x86_ea->valid_modrm = 0;    /* default to not yet valid */
 
+    /* A forced byte displacement can't be honored as written when it would
+     * be scaled; choose the length as usual instead.
+     */
+    if (x86_ea->ea.disp.size == 8 && scale > 1)
+        x86_ea->ea.disp.size = 0;
+
     switch (x86_ea->ea.disp.size) {
         case 0:
             break;
@@ -521,6 +548,15 @@ x86_checkea_calc_displen(x86_effaddr *x86_ea, unsigned int wordsize, int noreg,
      * so we ignore it for now.
      */
     num = yasm_value_get_intnum(&x86_ea->ea.disp, NULL, 0);
+    if (!num && scale > 1) {
+        /* Unknown values can't be checked for the disp8 scale later, so
+         * use the full size.
+         */
+        x86_ea->ea.disp.size = wordsize;
+        x86_ea->modrm |= 0200;
+        x86_ea->valid_modrm = 1;
+        return 0;
+    }
     if (!num) {
         /* Still has unknown values. */
         x86_ea->ea.need_nonzero_len = 1;
@@ -539,6 +575,25 @@ x86_checkea_calc_displen(x86_effaddr *x86_ea, unsigned int wordsize, int noreg,
          */
         yasm_value_delete(&x86_ea->ea.disp);
         x86_ea->ea.need_disp = 0;
+    } else if (scale > 1) {
+        long v = yasm_intnum_get_int(num);
+        if (v % (long)scale == 0 && v/(long)scale >= -128 &&
+            v/(long)scale <= 127) {
+            /* It fits into a scaled signed byte; store the quotient */
+            if (v != 0) {
+                unsigned long line = x86_ea->ea.disp.abs->line;
+                yasm_expr_destroy(x86_ea->ea.disp.abs);
+                x86_ea->ea.disp.abs = yasm_expr_create_ident(
+                    yasm_expr_int(yasm_intnum_create_int(v/(long)scale)),
+                    line);
+            }
+            x86_ea->disp8_n = 1;    /* already scaled */
+            x86_ea->ea.disp.size = 8;
+            x86_ea->modrm |= 0100;
+        } else {
+            x86_ea->ea.disp.size = wordsize;
+            x86_ea->modrm |= 0200;
+        }
     } else if (yasm_intnum_in_range(num, -128, 127)) {
         /* It fits into a signed byte */
         x86_ea->ea.disp.size = 8;
@@ -665,16 +720,17 @@ yasm_x86__expr_checkea(x86_effaddr *x86_ea, unsigned char *addrsize,
             REG64_RIP,
             SIMDREGS
         };
-        int reg3264mult[33] =
+        int reg3264mult[49] =
             {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
         x86_checkea_reg3264_data reg3264_data;
         int basereg = REG3264_NONE;     /* "base" register (for SIB) */
         int indexreg = REG3264_NONE;    /* "index" register (for SIB) */
         int regcount = 17;              /* normally don't check SIMD regs */
 
         if (x86_ea->vsib_mode != 0)
-            regcount = 33;
+            regcount = 49;
 
         /* We can only do 64-bit addresses in 64-bit mode. */
         if (*addrsize == 64 && bits != 64) {
@@ -905,7 +961,8 @@ yasm_x86__expr_checkea(x86_effaddr *x86_ea, unsigned char *addrsize,
             else {
                 if (indexreg >= SIMDREGS) {
                     if (yasm_x86__set_rex_from_reg(rex, &low3,
-                            (unsigned int)(X86_XMMREG | (indexreg-SIMDREGS)),
+                            (unsigned int)(X86_XMMREG |
+                                           ((indexreg-SIMDREGS) & 0xF)),
                             bits, X86_REX_X))
                         return 1;
                 } else {
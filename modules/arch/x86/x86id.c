@@ -33,8 +33,8 @@
 #include "modules/arch/x86/x86arch.h"
 
 
-static const char *cpu_find_reverse(unsigned int cpu0, unsigned int cpu1,
-                                    unsigned int cpu2);
+static const char *cpu_find_reverse(wordptr cpu_enabled, unsigned int cpu0,
+                                    unsigned int cpu1, unsigned int cpu2);
 
 /* Opcode modifiers. */
 #define MOD_Gap     0   /* Eats a parameter / does nothing */
@@ -76,6 +76,18 @@ enum x86_misc_flags {
     NOT_AVX = 1<<3          /* Not available (invalid) in AVX instruction */
 };
 
+/* AVX-512 operand decorators accepted by an EVEX instruction form */
+enum x86_evex_flags {
+    EVEX_MASK = 1<<0,       /* {k} write mask on the destination */
+    EVEX_ZERO = 1<<1,       /* {z} zeroing-masking */
+    EVEX_B32 = 1<<2,        /* {1toN} broadcast of 32-bit elements */
+    EVEX_B64 = 1<<3,        /* {1toN} broadcast of 64-bit elements */
+    EVEX_ER = 1<<4,         /* embedded rounding ({rn-sae} etc, or {sae}) */
+    EVEX_SAE = 1<<5,        /* {sae} only */
+    EVEX_MASKREQ = 1<<6,    /* write mask required (gather/scatter) */
+    EVEX_ELEM = 1<<7        /* disp8 scaled by the element (compress) */
+};
+
 enum x86_operand_type {
     OPT_Imm = 0,        /* immediate */
     OPT_Reg = 1,        /* any general purpose or FPU register */
@@ -114,13 +126,18 @@ enum x86_operand_type {
     /* XMM VSIB memory operand */
     OPT_MemXMMIndex = 27,
     /* YMM VSIB memory operand */
-    OPT_MemYMMIndex = 28
+    OPT_MemYMMIndex = 28,
+    OPT_EVEXReg = 29,   /* any XMM/YMM/ZMM register, including 16-31 */
+    OPT_EVEXRM = 30,    /* any XMM/YMM/ZMM register OR memory */
+    OPT_KReg = 31,      /* any AVX-512 opmask register */
+    /* ZMM VSIB memory operand */
+    OPT_MemZMMIndex = 32
 };
 
 enum x86_operand_size {
     /* any size acceptable/no size spec acceptable (dep. on strict) */
     OPS_Any = 0,
-    /* 8/16/32/64/80/128/256 bits (from user or reg size) */
+    /* 8/16/32/64/80/128/256/512 bits (from user or reg size) */
     OPS_8 = 1,
     OPS_16 = 2,
     OPS_32 = 3,
@@ -131,7 +148,8 @@ enum x86_operand_size {
     /* current BITS setting; when this is used the size matched
      * gets stored into the opersize as well.
      */
-    OPS_BITS = 8
+    OPS_BITS = 8,
+    OPS_512 = 9
 };
 
 enum x86_operand_targetmod {
@@ -193,7 +211,7 @@ typedef struct x86_info_operand {
      */
 
     /* general type (must be exact match, except for RM types): */
-    unsigned int type:5;
+    unsigned int type:6;
 
     /* size (user-specified, or from register size) */
     unsigned int size:4;
@@ -238,14 +256,17 @@ typedef struct x86_insn_info {
     /* Tests against BITS==64, AVX, and XOP */
     unsigned int misc_flags:5;
 
+    /* Operand decorators allowed (EVEX forms only) */
+    unsigned int evex_flags:8;
+
     /* The CPU feature flags needed to execute this instruction.  This is OR'ed
      * with arch-specific data[2].  This combined value is compared with
      * cpu_enabled to see if all bits set here are set in cpu_enabled--if so,
      * the instruction is available on this CPU.
      */
-    unsigned int cpu0:6;
-    unsigned int cpu1:6;
-    unsigned int cpu2:6;
+    unsigned int cpu0:7;
+    unsigned int cpu1:7;
+    unsigned int cpu2:7;
 
     /* Opcode modifiers for variations of instruction.  As each modifier reads
      * its parameter in LSB->MSB order from the arch-specific data[1] from the
@@ -276,6 +297,8 @@ typedef struct x86_insn_info {
      *      11: F2
      * 0x80 - 0x8F indicate a XOP prefix, with the four LSBs holding "WLpp":
      *  same meanings as VEX prefix.
+     * 0xA0 - 0xBF indicate an EVEX prefix, with the five LSBs holding
+     * "WLLpp": as for VEX, but with LL: 0=128-bit, 1=256-bit, 2=512-bit.
      */
     unsigned char special_prefix;
 
@@ -331,6 +354,25 @@ typedef struct x86_id_insn {
 
     /* Default rel setting at the time of parsing the instruction */
     unsigned int default_rel:1;
+
+    /* Conditional jump already padded along with the preceding instruction
+     * it may be macro-fused with.
+     */
+    unsigned int fused_jcc:1;
+
+    /* Branch padding boundary (0 if none), loop head alignment boundary
+     * (0 if none) and maximum skip, and the NOP fill for both at the time of
+     * parsing the instruction.
+     */
+    unsigned long align_branches;
+    unsigned int align_loops:16;
+    unsigned int align_loops_max_skip:16;
+    /*@null@*/ const unsigned char **branch_fill;
+
+    /* Byte counter to add shortest-encoding savings to, at the time of
+     * parsing the instruction (NULL if not optimizing encodings).
+     */
+    /*@null@*/ /*@dependent@*/ unsigned long *encoding_saved;
 } x86_id_insn;
 
 static void x86_id_insn_destroy(void *contents);
@@ -350,37 +392,70 @@ static const yasm_bytecode_callback x86_id_insn_callback = {
 
 #include "x86insns.c"
 
+/* VSIB index register search: the register type wanted, and whether
+ * registers 16-31 (EVEX forms only) are acceptable.
+ */
+typedef struct x86_simd_index_data {
+    x86_expritem_reg_size type;
+    int allow_hi;
+} x86_simd_index_data;
+
 /* Looks for the first SIMD register match for the purposes of VSIB matching.
  * Full legality checking is performed in EA code.
  */
 static int
 x86_expr_contains_simd_cb(const yasm_expr__item *ei, void *d)
 {
-    int ymm = *((int *)d);
+    x86_simd_index_data *data = (x86_simd_index_data *)d;
+    uintptr_t reg;
     if (ei->type != YASM_EXPR_REG)
         return 0;
-    switch ((x86_expritem_reg_size)(ei->data.reg & ~0xFUL)) {
-        case X86_XMMREG:
-            if (!ymm)
-                return 1;
-            break;
-        case X86_YMMREG:
-            if (ymm)
-                return 1;
-            break;
-        default:
-            break;
-    }
-    return 0;
+    reg = ei->data.reg;
+    if ((reg & X86_REG_HI) && data->allow_hi)
+        reg &= ~X86_REG_HI;
+    return (x86_expritem_reg_size)(reg & ~0xFUL) == data->type;
 }
 
 static int
-x86_expr_contains_simd(const yasm_expr *e, int ymm)
+x86_expr_contains_simd(const yasm_expr *e, x86_expritem_reg_size type,
+                       int allow_hi)
 {
-    return yasm_expr__traverse_leaves_in_const(e, &ymm,
+    x86_simd_index_data data;
+    data.type = type;
+    data.allow_hi = allow_hi;
+    return yasm_expr__traverse_leaves_in_const(e, &data,
                                                x86_expr_contains_simd_cb);
 }
 
+static int
+x86_expr_contains_simd_hi_cb(const yasm_expr__item *ei, void *d)
+{
+    return ei->type == YASM_EXPR_REG && (ei->data.reg & X86_REG_HI);
+}
+
+/* Register number (0-31) of a SIMD register, whatever its size. */
+static unsigned int
+x86_simd_regnum(uintptr_t reg)
+{
+    return (unsigned int)((reg & 0xF) | ((reg & X86_REG_HI) ? 16 : 0));
+}
+
+/* Looks for a SIMD register with the given number (of any size). */
+static int
+x86_expr_contains_simd_num_cb(const yasm_expr__item *ei, void *d)
+{
+    if (ei->type != YASM_EXPR_REG)
+        return 0;
+    switch ((x86_expritem_reg_size)(ei->data.reg & ~(0xFUL|X86_REG_HI))) {
+        case X86_XMMREG:
+        case X86_YMMREG:
+        case X86_ZMMREG:
+            return x86_simd_regnum(ei->data.reg) == *(unsigned int *)d;
+        default:
+            return 0;
+    }
+}
+
 static void
 x86_finalize_common(x86_common *common, const x86_insn_info *info,
                     unsigned int mode_bits)
@@ -527,6 +602,20 @@ x86_finalize_jmp(yasm_bytecode *bc, yasm_bytecode *prev_bc,
     yasm_value_set_curpos_rel(&jmp->target, bc, 0);
     jmp->target.jump_target = 1;
 
+    /* Align the target if it's a loop head, i.e. a label before us in this
+     * section (the optimizer figures out which targets are behind us).
+     */
+    if (id_insn->align_loops && id_insn->group != call_insn
+        && jmp->target.rel && !jmp->target.wrt && !bc->multiple) {
+        yasm_bytecode *target_prevbc;
+        if (yasm_symrec_get_label(jmp->target.rel, &target_prevbc)
+            && target_prevbc->section == bc->section)
+            yasm_section_align_loop_head(bc->section, target_prevbc, bc,
+                                         id_insn->align_loops,
+                                         id_insn->align_loops_max_skip,
+                                         id_insn->branch_fill);
+    }
+
     /* See if the user explicitly specified short/near/far. */
     switch (insn_operands[jinfo->operands_index+0].targetmod) {
         case OPTM_Short:
@@ -628,66 +717,63 @@ x86_find_match(x86_id_insn *id_insn, yasm_insn_operand **ops,
 {
     const x86_insn_info *info = id_insn->group;
     unsigned int num_info = id_insn->num_info;
+    unsigned int num_operands = id_insn->insn.num_operands;
     unsigned int suffix = id_insn->suffix;
     unsigned int mode_bits = id_insn->mode_bits;
+    int is_gas = (id_insn->parser == X86_PARSER_GAS);
+    unsigned int reject_misc, reject_gas;
     int found = 0;
 
+    /* Precompute the info flags that disqualify a form in the current mode,
+     * so each form can be rejected with a single test.
+     */
+    reject_misc = (mode_bits == 64) ? NOT_64 : ONLY_64;
+    reject_misc |= (id_insn->misc_flags & ONLY_AVX) ? NOT_AVX : ONLY_AVX;
+    reject_gas = is_gas ? GAS_ILLEGAL : GAS_ONLY;
+
     /* Just do a simple linear search through the info array for a match.
-     * First match wins.
+     * First match wins.  The cheap flag and operand count tests come first,
+     * as they reject most forms; the CPU feature tests are done last.
      */
     for (; num_info>0 && !found; num_info--, info++) {
         yasm_insn_operand *op, **use_ops;
-        const x86_info_operand *info_ops =
-            &insn_operands[info->operands_index];
+        const x86_info_operand *info_ops;
         unsigned int gas_flags = info->gas_flags;
-        unsigned int misc_flags = info->misc_flags;
         unsigned int size;
         int mismatch = 0;
         unsigned int i;
 
-        /* Match CPU */
-        if (mode_bits != 64 && (misc_flags & ONLY_64))
-            continue;
-        if (mode_bits == 64 && (misc_flags & NOT_64))
-            continue;
-
-        if (bypass != 8 &&
-            (!BitVector_bit_test(id_insn->cpu_enabled, info->cpu0) ||
-             !BitVector_bit_test(id_insn->cpu_enabled, info->cpu1) ||
-             !BitVector_bit_test(id_insn->cpu_enabled, info->cpu2)))
-            continue;
-
         /* Match # of operands */
-        if (id_insn->insn.num_operands != info->num_operands)
+        if (num_operands != info->num_operands)
             continue;
 
-        /* Match AVX */
-        if (!(id_insn->misc_flags & ONLY_AVX) && (misc_flags & ONLY_AVX))
-            continue;
-        if ((id_insn->misc_flags & ONLY_AVX) && (misc_flags & NOT_AVX))
+        /* Match BITS==64, AVX, and parser mode */
+        if ((info->misc_flags & reject_misc) || (gas_flags & reject_gas))
             continue;
 
-        /* Match parser mode */
-        if ((gas_flags & GAS_ONLY) && id_insn->parser != X86_PARSER_GAS)
-            continue;
-        if ((gas_flags & GAS_ILLEGAL) && id_insn->parser == X86_PARSER_GAS)
+        /* Match suffix (if required) */
+        if (is_gas && ((suffix & SUF_MASK) & (gas_flags & SUF_MASK)) == 0)
             continue;
 
-        /* Match suffix (if required) */
-        if (id_insn->parser == X86_PARSER_GAS
-            && ((suffix & SUF_MASK) & (gas_flags & SUF_MASK)) == 0)
+        /* Match CPU */
+        if (bypass != 8 &&
+            (!BitVector_bit_test(id_insn->cpu_enabled, info->cpu0) ||
+             !BitVector_bit_test(id_insn->cpu_enabled, info->cpu1) ||
+             !BitVector_bit_test(id_insn->cpu_enabled, info->cpu2)))
             continue;
 
         /* Use reversed operands in GAS mode if not otherwise specified */
         use_ops = ops;
-        if (id_insn->parser == X86_PARSER_GAS && !(gas_flags & GAS_NO_REV))
+        if (is_gas && !(gas_flags & GAS_NO_REV))
             use_ops = rev_ops;
 
-        if (id_insn->insn.num_operands == 0) {
+        if (num_operands == 0) {
             found = 1;      /* no operands -> must have a match here. */
             break;
         }
 
+        info_ops = &insn_operands[info->operands_index];
+
         /* Match each operand type and size */
         for (i = 0, op = use_ops[0]; op && i<info->num_operands && !mismatch;
              op = use_ops[++i]) {
@@ -888,12 +974,45 @@ x86_find_match(x86_id_insn *id_insn, yasm_insn_operand **ops,
                 }
                 case OPT_MemXMMIndex:
                     if (op->type != YASM_INSN__OPERAND_MEMORY ||
-                        !x86_expr_contains_simd(op->data.ea->disp.abs, 0))
+                        !x86_expr_contains_simd(op->data.ea->disp.abs,
+                            X86_XMMREG, (info->special_prefix & 0xE0) == 0xA0))
                         mismatch = 1;
                     break;
                 case OPT_MemYMMIndex:
                     if (op->type != YASM_INSN__OPERAND_MEMORY ||
-                        !x86_expr_contains_simd(op->data.ea->disp.abs, 1))
+                        !x86_expr_contains_simd(op->data.ea->disp.abs,
+                            X86_YMMREG, (info->special_prefix & 0xE0) == 0xA0))
+                        mismatch = 1;
+                    break;
+                case OPT_MemZMMIndex:
+                    if (op->type != YASM_INSN__OPERAND_MEMORY ||
+                        !x86_expr_contains_simd(op->data.ea->disp.abs,
+                            X86_ZMMREG, 1))
+                        mismatch = 1;
+                    break;
+                case OPT_EVEXRM:
+                    if (op->type == YASM_INSN__OPERAND_MEMORY)
+                        break;
+                    /*@fallthrough@*/
+                case OPT_EVEXReg:
+                    if (op->type != YASM_INSN__OPERAND_REG)
+                        mismatch = 1;
+                    else {
+                        switch ((x86_expritem_reg_size)
+                                (op->data.reg & ~(0xFUL|X86_REG_HI))) {
+                            case X86_XMMREG:
+                            case X86_YMMREG:
+                            case X86_ZMMREG:
+                                break;
+                            default:
+                                mismatch = 1;
+                                break;
+                        }
+                    }
+                    break;
+                case OPT_KReg:
+                    if (op->type != YASM_INSN__OPERAND_REG ||
+                        (op->data.reg & ~0xFUL) != X86_KREG)
                         mismatch = 1;
                     break;
                 default:
@@ -905,7 +1024,17 @@ x86_find_match(x86_id_insn *id_insn, yasm_insn_operand **ops,
 
             /* Check operand size */
             size = size_lookup[info_ops[i].size];
-            if (id_insn->parser == X86_PARSER_GAS) {
+            if (op->bcst) {
+                /* A broadcast memory operand is sized by its element, and
+                 * the element count must fill the vector.
+                 */
+                unsigned int elem = (info->evex_flags & EVEX_B64) ? 64 : 32;
+                if (op->type != YASM_INSN__OPERAND_MEMORY ||
+                    !(info->evex_flags & (EVEX_B32|EVEX_B64)) ||
+                    op->bcst*elem != size ||
+                    (op->size != 0 && op->size != elem))
+                    mismatch = 1;
+            } else if (is_gas) {
                 /* Require relaxed operands for GAS mode (don't allow
                  * per-operand sizing).
                  */
@@ -956,6 +1085,22 @@ x86_find_match(x86_id_insn *id_insn, yasm_insn_operand **ops,
                     mismatch = 1;
             }
 
+            if (mismatch)
+                break;
+
+            /* Check AVX-512 decorators; only EVEX forms accept them, and
+             * the write mask only on the destination.
+             */
+            if ((op->opmask && (i != 0 || !(info->evex_flags & EVEX_MASK)))
+                || (op->zeroing && (i != 0 ||
+                                    !(info->evex_flags & EVEX_ZERO)))
+                || (op->rounding != YASM_INSN_ROUND_NONE &&
+                    (op->type != YASM_INSN__OPERAND_REG ||
+                     !(info->evex_flags & (EVEX_ER|EVEX_SAE)) ||
+                     (op->rounding != YASM_INSN_ROUND_SAE &&
+                      !(info->evex_flags & EVEX_ER)))))
+                mismatch = 1;
+
             if (mismatch)
                 break;
 
@@ -1050,7 +1195,8 @@ x86_match_error(x86_id_insn *id_insn, yasm_insn_operand **ops,
             unsigned int cpu0 = i->cpu0, cpu1 = i->cpu1, cpu2 = i->cpu2;
             yasm_error_set(YASM_ERROR_TYPE,
                           N_("requires CPU%s"),
-                          cpu_find_reverse(cpu0, cpu1, cpu2));
+                          cpu_find_reverse(id_insn->cpu_enabled, cpu0, cpu1,
+                                           cpu2));
             break;
         }
         default:
@@ -1059,6 +1205,217 @@ x86_match_error(x86_id_insn *id_insn, yasm_insn_operand **ops,
     }
 }
 
+/* Can the CPU macro-fuse this instruction with a following conditional
+ * jump?  Covers the ALU forms Intel cores fuse (CMP, TEST, ADD, SUB, AND,
+ * INC, DEC); memory-immediate forms never fuse.
+ */
+static int
+x86_insn_fusible(const x86_id_insn *id_insn, yasm_insn_operand **ops)
+{
+    int mem = 0, imm = 0;
+    unsigned int i;
+
+    if (id_insn->group == arith_insn) {
+        switch (id_insn->mod_data[1]) {
+            case 0: /* add */
+            case 4: /* and */
+            case 5: /* sub */
+            case 7: /* cmp */
+                break;
+            default:
+                return 0;
+        }
+    } else if (id_insn->group != test_insn && id_insn->group != incdec_insn)
+        return 0;
+
+    for (i = 0; i < 5 && ops[i]; i++) {
+        if (ops[i]->type == YASM_INSN__OPERAND_MEMORY)
+            mem = 1;
+        else if (ops[i]->type == YASM_INSN__OPERAND_IMM)
+            imm = 1;
+    }
+    return !(mem && imm);
+}
+
+/* Insert branch padding ahead of a relative jump, or ahead of an
+ * instruction that will be macro-fused with the conditional jump following
+ * it, so the optimizer can keep the branch from crossing or ending on the
+ * branch alignment boundary.
+ */
+static void
+x86_pad_branch(yasm_bytecode *bc, yasm_bytecode *prev_bc,
+               const x86_insn_info *info, yasm_insn_operand **ops)
+{
+    x86_id_insn *id_insn = (x86_id_insn *)bc->contents;
+    unsigned int num_bcs;
+
+    if (bc->multiple)
+        return;
+
+    if (id_insn->insn.num_operands > 0 &&
+        insn_operands[info->operands_index+0].action == OPA_JmpRel) {
+        if (id_insn->fused_jcc)
+            return;     /* already padded as part of a fused pair */
+        num_bcs = 1;
+    } else if (x86_insn_fusible(id_insn, ops)) {
+        yasm_bytecode *next_bc = yasm_bc__next(bc);
+        x86_id_insn *next_insn;
+
+        if (!next_bc || next_bc->callback != &x86_id_insn_callback
+            || next_bc->multiple)
+            return;
+        next_insn = (x86_id_insn *)next_bc->contents;
+        if (next_insn->group != jcc_insn || next_insn->insn.num_prefixes > 0)
+            return;
+        next_insn->fused_jcc = 1;
+        num_bcs = 2;
+    } else
+        return;
+
+    yasm_section_bcs_insert_after(bc->section, prev_bc,
+        yasm_bc_create_branch_pad(id_insn->align_branches, num_bcs,
+                                  id_insn->branch_fill, bc->line));
+}
+
+/* Rename the 64-bit general registers among the operands to their 32-bit
+ * forms and look for a matching instruction form.  If there is none, the
+ * operands are put back as they were and NULL is returned.
+ */
+static const x86_insn_info *
+x86_match_narrowed(x86_id_insn *id_insn, yasm_insn_operand **ops,
+                   yasm_insn_operand **rev_ops,
+                   const unsigned int *size_lookup)
+{
+    const x86_insn_info *info;
+    unsigned int suffix = id_insn->suffix;
+    unsigned int i;
+
+    for (i = 0; i < 5 && ops[i]; i++) {
+        if (ops[i]->type == YASM_INSN__OPERAND_REG &&
+            (ops[i]->data.reg & ~0xFUL) == X86_REG64)
+            ops[i]->data.reg = X86_REG32 | (ops[i]->data.reg & 0xF);
+    }
+
+    /* A GAS "q" suffix no longer applies */
+    if (id_insn->parser == X86_PARSER_GAS)
+        id_insn->suffix = SUF_Z;
+
+    info = x86_find_match(id_insn, ops, rev_ops, size_lookup, 0);
+    if (!info) {
+        id_insn->suffix = suffix;
+        for (i = 0; i < 5 && ops[i]; i++) {
+            if (ops[i]->type == YASM_INSN__OPERAND_REG &&
+                (ops[i]->data.reg & ~0xFUL) == X86_REG32)
+                ops[i]->data.reg = X86_REG64 | (ops[i]->data.reg & 0xF);
+        }
+    }
+    return info;
+}
+
+/* Replace a 64-bit general register instruction by a shorter 32-bit one
+ * when the two have exactly the same result and flags:
+ *  - MOV reg64, imm with an unsigned 32-bit value (the 32-bit move zero
+ *    extends; 5 bytes instead of 7 or 10, one more for r8-r15)
+ *  - XOR/SUB reg64, reg64 of the same register (drops REX.W)
+ *  - AND/TEST reg64, imm with a non-negative 32-bit value (bit 31 of the
+ *    result is clear, so SF agrees; drops REX.W)
+ * Only constant immediates are considered, and nothing is done to strict
+ * operands.  Returns the (possibly new) instruction form.
+ */
+static const x86_insn_info *
+x86_shorten_insn(x86_id_insn *id_insn, yasm_insn_operand **ops,
+                 yasm_insn_operand **rev_ops, const unsigned int *size_lookup,
+                 const x86_insn_info *info)
+{
+    const x86_info_operand *info_ops = &insn_operands[info->operands_index];
+    yasm_insn_operand **use_ops = ops;
+    yasm_insn_operand *reg, *src;
+    const x86_insn_info *narrow;
+    /*@dependent@*/ /*@null@*/ const yasm_intnum *num = NULL;
+    unsigned long saved;
+
+    if (id_insn->mode_bits != 64 || info->num_operands != 2 ||
+        id_insn->force_strict)
+        return info;
+
+    if (id_insn->parser == X86_PARSER_GAS && !(info->gas_flags & GAS_NO_REV))
+        use_ops = rev_ops;
+    reg = use_ops[0];
+    src = use_ops[1];
+    if (reg->type != YASM_INSN__OPERAND_REG ||
+        (reg->data.reg & ~0xFUL) != X86_REG64 || src->strict)
+        return info;
+
+    if (src->type == YASM_INSN__OPERAND_IMM) {
+        num = yasm_expr_get_intnum(&src->data.val, 0);
+        if (!num || yasm_intnum_sign(num) < 0)
+            return info;
+    }
+
+    if (info_ops[1].post_action == OPAP_SImm32Avail) {
+        /* mov reg64, imm */
+        if (!num || !yasm_intnum_check_size(num, 32, 0, 0))
+            return info;
+        saved = yasm_intnum_check_size(num, 32, 0, 1) ? 2 : 5;
+        if ((reg->data.reg & 0x8) != 0)
+            saved--;    /* r8-r15 keep a REX prefix */
+    } else if ((reg->data.reg & 0x8) != 0) {
+        /* r8-r15 need REX anyway */
+        return info;
+    } else if (id_insn->group == arith_insn &&
+               (id_insn->mod_data[1] == 5 || id_insn->mod_data[1] == 6) &&
+               src->type == YASM_INSN__OPERAND_REG) {
+        /* sub/xor reg64, reg64 */
+        if (src->data.reg != reg->data.reg)
+            return info;
+        saved = 1;
+    } else if ((id_insn->group == test_insn ||
+                (id_insn->group == arith_insn && id_insn->mod_data[1] == 4))
+               && num) {
+        /* test/and reg64, imm */
+        if (!yasm_intnum_check_size(num, 32, 0, 1))
+            return info;
+        saved = 1;
+    } else
+        return info;
+
+    narrow = x86_match_narrowed(id_insn, ops, rev_ops, size_lookup);
+    if (!narrow)
+        return info;
+    *id_insn->encoding_saved += saved;
+    return narrow;
+}
+
+/* Can the two source operands of this VEX-encoded 0F map instruction be
+ * swapped without changing its result?  Scalar forms are not, as they copy
+ * the upper elements from the first source; neither is floating point
+ * arithmetic, which returns the first source's NaN when both are NaNs.
+ */
+static int
+x86_vex_commutative(unsigned char pp, unsigned char opcode)
+{
+    switch (opcode) {
+        case 0x54:  /* vandps/pd */
+        case 0x56:  /* vorps/pd */
+        case 0x57:  /* vxorps/pd */
+            return pp <= 1;
+        case 0x74: case 0x75: case 0x76:    /* vpcmpeqb/w/d */
+        case 0xD4: case 0xD5:               /* vpaddq, vpmullw */
+        case 0xDA: case 0xDB:               /* vpminub, vpand */
+        case 0xDC: case 0xDD: case 0xDE:    /* vpaddusb/w, vpmaxub */
+        case 0xE0: case 0xE3:               /* vpavgb/w */
+        case 0xE4: case 0xE5:               /* vpmulhuw, vpmulhw */
+        case 0xEA: case 0xEB:               /* vpminsw, vpor */
+        case 0xEC: case 0xED:               /* vpaddsb/w */
+        case 0xEE: case 0xEF:               /* vpmaxsw, vpxor */
+        case 0xF4: case 0xF5: case 0xF6:    /* vpmuludq, vpmaddwd, vpsadbw */
+        case 0xFC: case 0xFD: case 0xFE:    /* vpaddb/w/d */
+            return pp == 1;
+        default:
+            return 0;
+    }
+}
+
 static void
 x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
 {
@@ -1073,8 +1430,10 @@ x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
     unsigned char im_sign;
     unsigned char spare;
     unsigned char vexdata, vexreg;
+    unsigned char evex_aaa = 0, evex_z = 0, evex_b = 0, evex_rhi = 0;
+    unsigned int evex_rc = YASM_INSN_ROUND_NONE, evex_memsize = 0;
     unsigned int i;
-    unsigned int size_lookup[] = {0, 8, 16, 32, 64, 80, 128, 256, 0};
+    unsigned int size_lookup[] = {0, 8, 16, 32, 64, 80, 128, 256, 0, 512};
     unsigned long do_postop = 0;
 
     size_lookup[OPS_BITS] = mode_bits;
@@ -1142,6 +1501,12 @@ x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
         return;
     }
 
+    if (id_insn->encoding_saved)
+        info = x86_shorten_insn(id_insn, ops, rev_ops, size_lookup, info);
+
+    if (id_insn->align_branches)
+        x86_pad_branch(bc, prev_bc, info, ops);
+
     if (id_insn->insn.num_operands > 0) {
         switch (insn_operands[info->operands_index+0].action) {
             case OPA_JmpRel:
@@ -1171,11 +1536,12 @@ x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
     insn->postop = X86_POSTOP_NONE;
     insn->rex = 0;
 
-    /* Move VEX/XOP data (stored in special prefix) to separate location to
-     * allow overriding of special prefix by modifiers.
+    /* Move VEX/XOP/EVEX data (stored in special prefix) to separate location
+     * to allow overriding of special prefix by modifiers.
      */
     if ((insn->special_prefix & 0xF0) == 0xC0 ||
-        (insn->special_prefix & 0xF0) == 0x80) {
+        (insn->special_prefix & 0xF0) == 0x80 ||
+        (insn->special_prefix & 0xE0) == 0xA0) {
         vexdata = insn->special_prefix;
         insn->special_prefix = 0;
     }
@@ -1264,6 +1630,11 @@ x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
                                 yasm_x86__ea_create_reg(insn->x86_ea,
                                     (unsigned long)op->data.reg, &insn->rex,
                                     mode_bits);
+                            /* EVEX.X extends a register r/m to 5 bits; REX.X
+                             * is otherwise unused here, so carry it there.
+                             */
+                            if (op->data.reg & X86_REG_HI)
+                                insn->rex |= 0x42;
                             break;
                         case YASM_INSN__OPERAND_SEGREG:
                             yasm_internal_error(
@@ -1273,17 +1644,26 @@ x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
                                 yasm_error_set(YASM_ERROR_VALUE,
                                     N_("invalid segment in effective address"));
                             insn->x86_ea = (x86_effaddr *)op->data.ea;
+                            evex_memsize = size_lookup[info_ops[i].size];
                             if (info_ops[i].type == OPT_MemOffs)
                                 /* Special-case for MOV MemOffs instruction */
                                 yasm_x86__ea_set_disponly(insn->x86_ea);
-                            else if (info_ops[i].type == OPT_MemXMMIndex) {
+                            else if (info_ops[i].type == OPT_MemXMMIndex ||
+                                     info_ops[i].type == OPT_MemYMMIndex ||
+                                     info_ops[i].type == OPT_MemZMMIndex) {
                                 /* Remember VSIB mode */
-                                insn->x86_ea->vsib_mode = 1;
-                                insn->x86_ea->need_sib = 1;
-                            } else if (info_ops[i].type == OPT_MemYMMIndex) {
-                                /* Remember VSIB mode */
-                                insn->x86_ea->vsib_mode = 2;
+                                if (info_ops[i].type == OPT_MemXMMIndex)
+                                    insn->x86_ea->vsib_mode = 1;
+                                else if (info_ops[i].type == OPT_MemYMMIndex)
+                                    insn->x86_ea->vsib_mode = 2;
+                                else
+                                    insn->x86_ea->vsib_mode = 3;
                                 insn->x86_ea->need_sib = 1;
+                                /* EVEX.V' extends the index to 5 bits */
+                                if (yasm_expr__traverse_leaves_in_const(
+                                        op->data.ea->disp.abs, NULL,
+                                        x86_expr_contains_simd_hi_cb))
+                                    vexreg |= 0x10;
                             } else if (id_insn->default_rel &&
                                        !op->data.ea->not_pc_rel &&
                                        op->data.ea->segreg != 0x6404 &&
@@ -1339,6 +1719,8 @@ x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
                         if (yasm_x86__set_rex_from_reg(&insn->rex, &spare,
                                 op->data.reg, mode_bits, X86_REX_R))
                             return;
+                        if (op->data.reg & X86_REG_HI)
+                            evex_rhi = 1;
                     } else
                         yasm_internal_error(N_("invalid operand conversion"));
                     break;
@@ -1348,6 +1730,8 @@ x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
                     if (yasm_x86__set_rex_from_reg(&insn->rex, &spare,
                             op->data.reg, mode_bits, X86_REX_R))
                         return;
+                    if (op->data.reg & X86_REG_HI)
+                        evex_rhi = 1;
                     vexreg = op->data.reg & 0xF;
                     break;
                 case OPA_Op0Add:
@@ -1414,7 +1798,8 @@ x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
                 case OPA_VEX:
                     if (op->type != YASM_INSN__OPERAND_REG)
                         yasm_internal_error(N_("invalid operand conversion"));
-                    vexreg = op->data.reg & 0xF;
+                    vexreg = (unsigned char)((op->data.reg & 0xF) |
+                                             ((op->data.reg & X86_REG_HI)>>4));
                     break;
                 case OPA_VEXImmSrc:
                     if (op->type != YASM_INSN__OPERAND_REG)
@@ -1471,6 +1856,29 @@ x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
             if (info_ops[i].size == OPS_BITS)
                 insn->common.opersize = (unsigned char)mode_bits;
 
+            /* Collect AVX-512 decorators (checked by x86_find_match) */
+            if (op->opmask) {
+                if ((op->opmask & ~0xFUL) != X86_KREG)
+                    yasm_error_set(YASM_ERROR_TYPE,
+                                   N_("write mask must be a k register"));
+                else if ((op->opmask & 0xF) == 0)
+                    yasm_error_set(YASM_ERROR_TYPE,
+                                   N_("k0 cannot be used as a write mask"));
+                evex_aaa = (unsigned char)(op->opmask & 7);
+            }
+            if (op->zeroing) {
+                if (!op->opmask)
+                    yasm_error_set(YASM_ERROR_TYPE,
+                                   N_("zeroing-masking requires a write mask"));
+                evex_z = 1;
+            }
+            if (op->bcst)
+                evex_b = 1;
+            if (op->rounding != YASM_INSN_ROUND_NONE) {
+                evex_b = 1;
+                evex_rc = op->rounding;
+            }
+
             switch (info_ops[i].post_action) {
                 case OPAP_None:
                     break;
@@ -1502,6 +1910,21 @@ x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
                         N_("unknown operand postponed action"));
             }
         }
+
+        /* An EVEX gather raises #UD if its destination is also the index
+         * register.  (VEX gathers have the same rule for the mask, but
+         * existing sources rely on it being accepted.)
+         */
+        if (insn->x86_ea && insn->x86_ea->vsib_mode != 0 &&
+            (info->evex_flags & EVEX_MASKREQ) &&
+            info_ops[0].action == OPA_Spare) {
+            unsigned int dest = x86_simd_regnum(use_ops[0]->data.reg);
+
+            if (yasm_expr__traverse_leaves_in_const(insn->x86_ea->ea.disp.abs,
+                    &dest, x86_expr_contains_simd_num_cb))
+                yasm_error_set(YASM_ERROR_TYPE,
+                    N_("gather destination must differ from the index register"));
+        }
     }
 
     if (insn->x86_ea) {
@@ -1593,9 +2016,11 @@ x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
      * the second two VEX/XOP bytes.  During calc_len() it may be shortened to
      * one VEX byte (this can only be done after knowledge of REX value); this
      * further optimization is not possible for XOP.
+     * EVEX is handled the same way, but with three payload bytes.
      */
     if (vexdata) {
         int xop = ((vexdata & 0xF0) == 0x80);
+        int evex = ((vexdata & 0xE0) == 0xA0);
         unsigned char vex1 = 0xE0;  /* R=X=B=1, mmmmm=0 */
         unsigned char vex2;
 
@@ -1648,19 +2073,78 @@ x86_id_insn_finalize(yasm_bytecode *bc, yasm_bytecode *prev_bc)
             }
         }
 
-        /* 2nd VEX byte is WvvvvLpp.
-         * W, L, pp come from vexdata
-         * vvvv comes from 1s complement of vexreg
-         */
-        vex2 = (((vexdata & 0x8) << 4) |                /* W */
-                ((15 - (vexreg & 0xF)) << 3) |          /* vvvv */
-                (vexdata & 0x7));                       /* Lpp */
-
-        /* Save to special_prefix and opcode */
-        insn->special_prefix = xop ? 0x8F : 0xC4;   /* VEX/XOP prefix */
-        insn->opcode.opcode[0] = vex1;
-        insn->opcode.opcode[1] = vex2;
-        insn->opcode.len = 3;   /* two prefix bytes and 1 opcode byte */
+        if (evex) {
+            /* EVEX payload bytes are RXBR'00mm, Wvvvv1pp, and zL'Lbv'aaa.
+             * R, X, B, and W are merged in from REX in tobytes() as for VEX;
+             * R' and V' (the fifth register number bits) are set here.
+             * Embedded rounding replaces the vector length with the RC;
+             * {sae} alone leaves it zero.
+             */
+            unsigned char ll = (vexdata >> 2) & 3;
+            if (evex_rc == YASM_INSN_ROUND_SAE)
+                ll = 0;
+            else if (evex_rc != YASM_INSN_ROUND_NONE)
+                ll = (unsigned char)(evex_rc - YASM_INSN_ROUND_RN_SAE);
+
+            /* Gathers and scatters use the mask to track completion */
+            if ((info->evex_flags & EVEX_MASKREQ) && !evex_aaa)
+                yasm_error_set(YASM_ERROR_TYPE,
+                               N_("instruction requires a write mask"));
+
+            insn->opcode.opcode[3] = insn->opcode.opcode[2];
+            insn->opcode.opcode[0] = (vex1 & 0x03) | (evex_rhi ? 0 : 0x10);
+            insn->opcode.opcode[1] = (unsigned char)
+                (((vexdata & 0x10) << 3) |              /* W */
+                 ((15 - (vexreg & 0xF)) << 3) |         /* vvvv */
+                 0x04 | (vexdata & 0x03));              /* pp */
+            insn->opcode.opcode[2] = (unsigned char)
+                ((evex_z << 7) | (ll << 5) | (evex_b << 4) |
+                 ((vexreg & 0x10) ? 0 : 0x08) |         /* V' */
+                 evex_aaa);
+            insn->special_prefix = 0x62;
+            insn->opcode.len = 4;   /* three prefix bytes and 1 opcode byte */
+
+            /* Compressed disp8 is scaled by the memory operand size, or by
+             * the element size when broadcasting or compressing.
+             */
+            if (insn->x86_ea && evex_memsize) {
+                if (info->evex_flags & EVEX_ELEM)
+                    insn->x86_ea->disp8_n = (vexdata & 0x10) ? 8 : 4;
+                else
+                    insn->x86_ea->disp8_n = (unsigned char)(!evex_b ?
+                        evex_memsize/8 : (info->evex_flags & EVEX_B64) ? 8 : 4);
+            }
+        } else {
+            /* When optimizing encodings, a commutative operation with only
+             * its second source in xmm8-15 can have its sources swapped so
+             * REX.B clears and the two byte VEX form becomes usable.
+             */
+            if (id_insn->encoding_saved && !xop && (vex1 & 0x1F) == 1 &&
+                (vexdata & 0x8) == 0 && insn->rex != 0xff &&
+                (insn->rex & 0x03) == 0x01 && vexreg < 8 &&
+                insn->x86_ea && (insn->x86_ea->modrm & 0xC0) == 0xC0 &&
+                x86_vex_commutative(vexdata & 0x3, insn->opcode.opcode[2])) {
+                unsigned char rm = insn->x86_ea->modrm & 0x7;
+                insn->x86_ea->modrm = (insn->x86_ea->modrm & ~0x7) | vexreg;
+                insn->rex &= ~0x01;
+                vexreg = rm | 8;
+                (*id_insn->encoding_saved)++;
+            }
+
+            /* 2nd VEX byte is WvvvvLpp.
+             * W, L, pp come from vexdata
+             * vvvv comes from 1s complement of vexreg
+             */
+            vex2 = (((vexdata & 0x8) << 4) |                /* W */
+                    ((15 - (vexreg & 0xF)) << 3) |          /* vvvv */
+                    (vexdata & 0x7));                       /* Lpp */
+
+            /* Save to special_prefix and opcode */
+            insn->special_prefix = xop ? 0x8F : 0xC4;   /* VEX/XOP prefix */
+            insn->opcode.opcode[0] = vex1;
+            insn->opcode.opcode[1] = vex2;
+            insn->opcode.len = 3;   /* two prefix bytes and 1 opcode byte */
+        }
     }
 
     x86_id_insn_clear_operands(id_insn);
@@ -1695,99 +2179,132 @@ typedef struct insnprefix_parse_data {
     unsigned int misc_flags:6;
 
     /* CPU flags */
-    unsigned int cpu0:6;
-    unsigned int cpu1:6;
-    unsigned int cpu2:6;
+    unsigned int cpu0:7;
+    unsigned int cpu1:7;
+    unsigned int cpu2:7;
 } insnprefix_parse_data;
 
 /* Pull in all parse data */
 #include "x86insn_nasm.c"
 #include "x86insn_gas.c"
 
+/* Feature names for error messages, in the order they are listed */
+static const struct {
+    unsigned int cpu;
+    const char *name;
+} cpu_names[] = {
+    {CPU_Prot,        "Protected"},
+    {CPU_Undoc,       "Undocumented"},
+    {CPU_Obs,         "Obsolete"},
+    {CPU_Priv,        "Privileged"},
+    {CPU_FPU,         "FPU"},
+    {CPU_MMX,         "MMX"},
+    {CPU_SSE,         "SSE"},
+    {CPU_SSE2,        "SSE2"},
+    {CPU_SSE3,        "SSE3"},
+    {CPU_3DNow,       "3DNow"},
+    {CPU_Cyrix,       "Cyrix"},
+    {CPU_AMD,         "AMD"},
+    {CPU_SMM,         "SMM"},
+    {CPU_SVM,         "SVM"},
+    {CPU_PadLock,     "PadLock"},
+    {CPU_EM64T,       "EM64T"},
+    {CPU_SSSE3,       "SSSE3"},
+    {CPU_SSE41,       "SSE4.1"},
+    {CPU_SSE42,       "SSE4.2"},
+    {CPU_SSE4a,       "SSE4a"},
+    {CPU_XSAVE,       "XSAVE"},
+    {CPU_AVX,         "AVX"},
+    {CPU_FMA,         "FMA"},
+    {CPU_AES,         "AES"},
+    {CPU_CLMUL,       "CLMUL"},
+    {CPU_MOVBE,       "MOVBE"},
+    {CPU_XOP,         "XOP"},
+    {CPU_FMA4,        "FMA4"},
+    {CPU_F16C,        "F16C"},
+    {CPU_FSGSBASE,    "FSGSBASE"},
+    {CPU_RDRAND,      "RDRAND"},
+    {CPU_XSAVEOPT,    "XSAVEOPT"},
+    {CPU_EPTVPID,     "EPTVPID"},
+    {CPU_SMX,         "SMX"},
+    {CPU_AVX2,        "AVX2"},
+    {CPU_BMI1,        "BMI1"},
+    {CPU_BMI2,        "BMI2"},
+    {CPU_INVPCID,     "INVPCID"},
+    {CPU_LZCNT,       "LZCNT"},
+    {CPU_TBM,         "TBM"},
+    {CPU_TSX,         "TSX"},
+    {CPU_SHA,         "SHA"},
+    {CPU_SMAP,        "SMAP"},
+    {CPU_RDSEED,      "RDSEED"},
+    {CPU_ADX,         "ADX"},
+    {CPU_PRFCHW,      "PRFCHW"},
+    {CPU_AVX512F,     "AVX512F"},
+    {CPU_AVX512CD,    "AVX512CD"},
+    {CPU_AVX512BW,    "AVX512BW"},
+    {CPU_AVX512DQ,    "AVX512DQ"},
+    {CPU_AVX512VL,    "AVX512VL"},
+    {CPU_VAES,        "VAES"},
+    {CPU_VPCLMULQDQ,  "VPCLMULQDQ"},
+    {CPU_GFNI,        "GFNI"},
+    {CPU_AVXVNNI,     "AVX-VNNI"},
+    {CPU_AVXIFMA,     "AVX-IFMA"},
+    {CPU_MOVDIRI,     "MOVDIRI"},
+    {CPU_SERIALIZE,   "SERIALIZE"},
+    {CPU_186,         "186"},
+    {CPU_286,         "286"},
+    {CPU_386,         "386"},
+    {CPU_486,         "486"},
+    {CPU_586,         "586"},
+    {CPU_686,         "686"},
+    {CPU_P3,          "P3"},
+    {CPU_P4,          "P4"},
+    {CPU_IA64,        "IA64"},
+    {CPU_K6,          "K6"},
+    {CPU_Athlon,      "Athlon"},
+    {CPU_Hammer,      "Hammer"}
+};
+
+/* Names the features among cpu0-cpu2 that cpu_enabled lacks, so messages
+ * list exactly what the active CPU setting is missing.
+ */
 static const char *
-cpu_find_reverse(unsigned int cpu0, unsigned int cpu1, unsigned int cpu2)
+cpu_find_reverse(wordptr cpu_enabled, unsigned int cpu0, unsigned int cpu1,
+                 unsigned int cpu2)
 {
     static char cpuname[200];
-    wordptr cpu = BitVector_Create(128, TRUE);
-
-    if (cpu0 != CPU_Any)
-        BitVector_Bit_On(cpu, cpu0);
-    if (cpu1 != CPU_Any)
-        BitVector_Bit_On(cpu, cpu1);
-    if (cpu2 != CPU_Any)
-        BitVector_Bit_On(cpu, cpu2);
+    size_t i;
 
     cpuname[0] = '\0';
 
-    if (BitVector_bit_test(cpu, CPU_Prot))
-        strcat(cpuname, " Protected");
-    if (BitVector_bit_test(cpu, CPU_Undoc))
-        strcat(cpuname, " Undocumented");
-    if (BitVector_bit_test(cpu, CPU_Obs))
-        strcat(cpuname, " Obsolete");
-    if (BitVector_bit_test(cpu, CPU_Priv))
-        strcat(cpuname, " Privileged");
-
-    if (BitVector_bit_test(cpu, CPU_FPU))
-        strcat(cpuname, " FPU");
-    if (BitVector_bit_test(cpu, CPU_MMX))
-        strcat(cpuname, " MMX");
-    if (BitVector_bit_test(cpu, CPU_SSE))
-        strcat(cpuname, " SSE");
-    if (BitVector_bit_test(cpu, CPU_SSE2))
-        strcat(cpuname, " SSE2");
-    if (BitVector_bit_test(cpu, CPU_SSE3))
-        strcat(cpuname, " SSE3");
-    if (BitVector_bit_test(cpu, CPU_3DNow))
-        strcat(cpuname, " 3DNow");
-    if (BitVector_bit_test(cpu, CPU_Cyrix))
-        strcat(cpuname, " Cyrix");
-    if (BitVector_bit_test(cpu, CPU_AMD))
-        strcat(cpuname, " AMD");
-    if (BitVector_bit_test(cpu, CPU_SMM))
-        strcat(cpuname, " SMM");
-    if (BitVector_bit_test(cpu, CPU_SVM))
-        strcat(cpuname, " SVM");
-    if (BitVector_bit_test(cpu, CPU_PadLock))
-        strcat(cpuname, " PadLock");
-    if (BitVector_bit_test(cpu, CPU_EM64T))
-        strcat(cpuname, " EM64T");
-    if (BitVector_bit_test(cpu, CPU_SSSE3))
-        strcat(cpuname, " SSSE3");
-    if (BitVector_bit_test(cpu, CPU_SSE41))
-        strcat(cpuname, " SSE4.1");
-    if (BitVector_bit_test(cpu, CPU_SSE42))
-        strcat(cpuname, " SSE4.2");
-
-    if (BitVector_bit_test(cpu, CPU_186))
-        strcat(cpuname, " 186");
-    if (BitVector_bit_test(cpu, CPU_286))
-        strcat(cpuname, " 286");
-    if (BitVector_bit_test(cpu, CPU_386))
-        strcat(cpuname, " 386");
-    if (BitVector_bit_test(cpu, CPU_486))
-        strcat(cpuname, " 486");
-    if (BitVector_bit_test(cpu, CPU_586))
-        strcat(cpuname, " 586");
-    if (BitVector_bit_test(cpu, CPU_686))
-        strcat(cpuname, " 686");
-    if (BitVector_bit_test(cpu, CPU_P3))
-        strcat(cpuname, " P3");
-    if (BitVector_bit_test(cpu, CPU_P4))
-        strcat(cpuname, " P4");
-    if (BitVector_bit_test(cpu, CPU_IA64))
-        strcat(cpuname, " IA64");
-    if (BitVector_bit_test(cpu, CPU_K6))
-        strcat(cpuname, " K6");
-    if (BitVector_bit_test(cpu, CPU_Athlon))
-        strcat(cpuname, " Athlon");
-    if (BitVector_bit_test(cpu, CPU_Hammer))
-        strcat(cpuname, " Hammer");
-
-    BitVector_Destroy(cpu);
+    for (i=0; i<NELEMS(cpu_names); i++) {
+        unsigned int cpu = cpu_names[i].cpu;
+        if ((cpu == cpu0 || cpu == cpu1 || cpu == cpu2) &&
+            !BitVector_bit_test(cpu_enabled, cpu)) {
+            strcat(cpuname, " ");
+            strcat(cpuname, cpu_names[i].name);
+        }
+    }
+
     return cpuname;
 }
 
+/* Count an instruction by mnemonic (as written) for --insn-stats */
+static void
+x86_count_mnemonic(x86_insn_stats *stats, const char *name)
+{
+    x86_mnemonic_count *mc = HAMT_search(stats->mnemonics, name);
+
+    if (!mc) {
+        int replace = 0;
+        mc = yasm_xmalloc(sizeof(x86_mnemonic_count));
+        mc->name = name;
+        mc->count = 0;
+        HAMT_insert(stats->mnemonics, name, mc, &replace, yasm_xfree);
+    }
+    mc->count++;
+}
+
 yasm_arch_insnprefix
 yasm_x86__parse_check_insnprefix(yasm_arch *arch, const char *id,
                                  size_t id_len, unsigned long line,
@@ -1796,12 +2313,12 @@ yasm_x86__parse_check_insnprefix(yasm_arch *arch, const char *id,
     yasm_arch_x86 *arch_x86 = (yasm_arch_x86 *)arch;
     /*@null@*/ const insnprefix_parse_data *pdata;
     size_t i;
-    static char lcaseid[17];
+    static char lcaseid[21];
 
     *bc = (yasm_bytecode *)NULL;
     *prefix = 0;
 
-    if (id_len > 16)
+    if (id_len > 20)
         return YASM_ARCH_NOTINSNPREFIX;
     for (i=0; i<id_len; i++)
         lcaseid[i] = tolower(id[i]);
@@ -1851,6 +2368,12 @@ yasm_x86__parse_check_insnprefix(yasm_arch *arch, const char *id,
 	
             id_insn->force_strict = arch_x86->force_strict != 0;
             id_insn->default_rel = arch_x86->default_rel != 0;
+            id_insn->fused_jcc = 0;
+            id_insn->align_branches = 0;
+            id_insn->align_loops = 0;
+            id_insn->align_loops_max_skip = 0;
+            id_insn->branch_fill = NULL;
+            id_insn->encoding_saved = NULL;
             *bc = yasm_bc_create_common(&x86_id_insn_callback, id_insn, line);
             return YASM_ARCH_INSN;
         }
@@ -1864,7 +2387,7 @@ yasm_x86__parse_check_insnprefix(yasm_arch *arch, const char *id,
             !BitVector_bit_test(cpu_enabled, cpu2)) {
             yasm_warn_set(YASM_WARN_GENERAL,
                           N_("`%s' is an instruction in CPU%s"), id,
-                          cpu_find_reverse(cpu0, cpu1, cpu2));
+                          cpu_find_reverse(cpu_enabled, cpu0, cpu1, cpu2));
             return YASM_ARCH_NOTINSNPREFIX;
         }
 
@@ -1882,6 +2405,17 @@ yasm_x86__parse_check_insnprefix(yasm_arch *arch, const char *id,
         id_insn->parser = PARSER(arch_x86);
         id_insn->force_strict = arch_x86->force_strict != 0;
         id_insn->default_rel = arch_x86->default_rel != 0;
+        id_insn->fused_jcc = 0;
+        id_insn->align_branches = arch_x86->align_branches;
+        id_insn->align_loops = arch_x86->align_loops;
+        id_insn->align_loops_max_skip = arch_x86->align_loops_max_skip;
+        id_insn->branch_fill =
+            (arch_x86->align_branches || arch_x86->align_loops) ?
+            yasm_arch_get_fill(arch) : NULL;
+        id_insn->encoding_saved = arch_x86->optimize_encoding ?
+            &arch_x86->encoding_saved : NULL;
+        if (arch_x86->insn_stats)
+            x86_count_mnemonic(arch_x86->insn_stats, pdata->name);
         *bc = yasm_bc_create_common(&x86_id_insn_callback, id_insn, line);
         return YASM_ARCH_INSN;
     } else {
@@ -1945,6 +2479,12 @@ yasm_x86__create_empty_insn(yasm_arch *arch, unsigned long line)
     id_insn->parser = PARSER(arch_x86);
     id_insn->force_strict = arch_x86->force_strict != 0;
     id_insn->default_rel = arch_x86->default_rel != 0;
+    id_insn->fused_jcc = 0;
+    id_insn->align_branches = 0;
+    id_insn->align_loops = 0;
+    id_insn->align_loops_max_skip = 0;
+    id_insn->branch_fill = NULL;
+    id_insn->encoding_saved = NULL;
 
     return yasm_bc_create_common(&x86_id_insn_callback, id_insn, line);
 }
@@ -1416,6 +1416,102 @@ bin_objfmt_init_new_section(yasm_section *sect, unsigned long line)
                           SSYM_LENGTH, line);
 }
 
+typedef struct bin_layout_info {
+    /*@only@*/ yasm_section **sects;
+    size_t num_sects;
+    size_t alloc_sects;
+} bin_layout_info;
+
+static int
+bin_layout_add_section(yasm_section *sect, /*@null@*/ void *d)
+{
+    bin_layout_info *info = (bin_layout_info *)d;
+
+    if (info->num_sects >= info->alloc_sects) {
+        info->alloc_sects = info->alloc_sects ? info->alloc_sects*2 : 8;
+        info->sects = yasm_xrealloc(info->sects,
+                                    info->alloc_sects*sizeof(yasm_section *));
+    }
+    info->sects[info->num_sects++] = sect;
+    return 0;
+}
+
+/* Is any section before index "end" declared to follow the named section? */
+static int
+bin_layout_is_followed(const bin_layout_info *info, size_t end,
+                       const char *name)
+{
+    size_t i;
+
+    for (i=0; i<end; i++) {
+        bin_section_data *bsd =
+            yasm_section_get_data(info->sects[i], &bin_section_data_cb);
+        if (bsd->follows && strcmp(bsd->follows, name) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+/* Tell the optimizer which sections will be placed directly after the
+ * section preceding them in the object, so that relative jumps between them
+ * can be sized.  This follows the LMA ordering rules in bin_objfmt_output(),
+ * but only recognizes the simple cases where no other section can end up in
+ * between.  Any section with virtual address attributes is left unlinked.
+ */
+static void
+bin_objfmt_update_layout(yasm_object *object)
+{
+    bin_layout_info info;
+    size_t i;
+    int seen_start = 0;
+
+    info.sects = NULL;
+    info.num_sects = 0;
+    info.alloc_sects = 0;
+    yasm_object_sections_traverse(object, &info, bin_layout_add_section);
+
+    for (i=0; i<info.num_sects; i++) {
+        yasm_section *sect = info.sects[i];
+        bin_section_data *bsd = yasm_section_get_data(sect,
+                                                      &bin_section_data_cb);
+        bin_section_data *prev_bsd = NULL;
+        const char *prev_name = NULL;
+        int follows = 0;
+
+        if (i > 0) {
+            prev_bsd = yasm_section_get_data(info.sects[i-1],
+                                             &bin_section_data_cb);
+            prev_name = yasm_section_get_name(info.sects[i-1]);
+        }
+
+        if (i == 0 || bsd->bss || prev_bsd->bss || bsd->vstart
+            || bsd->vfollows || bsd->valign || prev_bsd->vstart
+            || prev_bsd->vfollows || prev_bsd->valign)
+            follows = 0;
+        else if (bsd->follows)
+            /* First section to follow the previous section goes right after
+             * it.
+             */
+            follows = strcmp(bsd->follows, prev_name) == 0
+                && !bin_layout_is_followed(&info, i, prev_name);
+        else if (!bsd->start && !prev_bsd->follows)
+            /* Both in the top-level list, with nothing following the
+             * previous section, and the previous section not sorted by
+             * start address ahead of earlier sections.
+             */
+            follows = (!prev_bsd->start || !seen_start)
+                && !bin_layout_is_followed(&info, info.num_sects, prev_name);
+
+        yasm_section_set_layout_follows(sect, follows,
+            bsd->align ? yasm_intnum_get_uint(bsd->align) : 4);
+
+        if (i > 0 && prev_bsd->start)
+            seen_start = 1;
+    }
+
+    yasm_xfree(info.sects);
+}
+
 static yasm_section *
 bin_objfmt_add_default_section(yasm_object *object)
 {
@@ -1423,8 +1519,10 @@ bin_objfmt_add_default_section(yasm_object *object)
     int isnew;
 
     retval = yasm_object_get_general(object, ".text", 0, 1, 0, &isnew, 0);
-    if (isnew)
+    if (isnew) {
         yasm_section_set_default(retval, 1);
+        bin_objfmt_update_layout(object);
+    }
     return retval;
 }
 
@@ -1579,6 +1677,9 @@ bin_objfmt_section_switch(yasm_object *object, yasm_valparamhead *valparams,
     bsd->follows = data.follows;
     bsd->vfollows = data.vfollows;
 
+    if (isnew || vp)
+        bin_objfmt_update_layout(object);
+
     return retval;
 }
 
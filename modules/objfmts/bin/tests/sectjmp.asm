@@ -0,0 +1,24 @@
+; Jumps between sections laid out next to each other are sized like
+; jumps within a section.
+bits 32
+section .text.hot
+hot:
+	test eax, eax
+	jz cold_path		; short
+	jmp cold_end		; near, past the end of short range
+back:
+	ret
+
+section .text.cold
+cold_path:
+	inc eax
+	jmp back		; short
+	times 200 nop
+cold_end:
+	ret
+
+section .text.tail follows=.text.cold align=16
+	jmp cold_end		; short, across alignment padding
+
+section .text.far start=0x100
+	jmp hot			; near, not adjacent
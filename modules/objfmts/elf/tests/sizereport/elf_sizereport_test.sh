@@ -0,0 +1,3 @@
+#! /bin/sh
+${srcdir}/text_test.sh elf_sizereport_test modules/objfmts/elf/tests/sizereport "elf size report" "-m amd64 -f elf --size-report=-" ".txt"
+exit $?
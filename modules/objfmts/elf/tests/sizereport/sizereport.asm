@@ -0,0 +1,24 @@
+; Per-function sizes, alignment padding and relocation counts.
+extern ext_func
+extern ext_data
+
+section .text
+global first
+global second
+first:
+	push rbp
+	call ext_func
+	mov rax, [rel ext_data]
+.loop:
+	dec rax
+	jnz .loop
+	pop rbp
+	ret
+align 16
+second:
+	call ext_func
+	ret
+
+section .data
+table:
+	dq first, second, ext_data
@@ -109,6 +109,7 @@ destroy_curtok_(yasm_parser_gas *parser_gas)
         case ID:
         case LABEL:
         case STRING:
+        case DECORATOR:
             yasm_xfree(curval.str.contents);
             break;
         default:
@@ -952,15 +953,47 @@ parse_instr(yasm_parser_gas *parser_gas)
 
             /* parse operands */
             for (;;) {
-                yasm_insn_operand *op = parse_operand(parser_gas);
+                yasm_insn_operand *op;
+                /*@null@*/ char *rounding = NULL;
+
+                /* A rounding control such as {rn-sae} is written as a
+                 * separate leading operand, but applies to the next one.
+                 */
+                if (curtok == DECORATOR) {
+                    rounding = DECORATOR_val;
+                    get_next_token();
+                    if (!expect(',')) {
+                        yasm_xfree(rounding);
+                        yasm_bc_destroy(bc);
+                        return NULL;
+                    }
+                    get_next_token();
+                }
+
+                op = parse_operand(parser_gas);
                 if (!op) {
                     yasm_error_set(YASM_ERROR_SYNTAX,
                                    N_("expression syntax error"));
+                    if (rounding)
+                        yasm_xfree(rounding);
                     yasm_bc_destroy(bc);
                     return NULL;
                 }
                 yasm_insn_ops_append(insn, op);
 
+                if (rounding) {
+                    yasm_operand_add_decorator(op, p_object->arch, rounding);
+                    yasm_xfree(rounding);
+                }
+
+                /* Trailing decorators ({%k1}, {z}, {1to16}) */
+                while (curtok == DECORATOR) {
+                    yasm_operand_add_decorator(op, p_object->arch,
+                                               DECORATOR_val);
+                    yasm_xfree(DECORATOR_val);
+                    get_next_token();
+                }
+
                 if (is_eol())
                     break;
                 if (!expect(',')) {
@@ -48,6 +48,7 @@ enum tokentype {
     LABEL,
     CPP_LINE_MARKER,
     NASM_LINE_MARKER,
+    DECORATOR,
     NONE
 };
 
@@ -146,6 +147,7 @@ typedef struct yasm_parser_gas {
 #define ID_len                  (curval.str.len)
 #define LABEL_val               (curval.str.contents)
 #define LABEL_len               (curval.str.len)
+#define DECORATOR_val           (curval.str.contents)
 
 #define cur_line        (yasm_linemap_get_current(parser_gas->linemap))
 
@@ -116,6 +116,7 @@ destroy_curtok_(yasm_parser_nasm *parser_nasm)
         case LOCAL_ID:
         case SPECIAL_ID:
         case NONLOCAL_ID:
+        case DECORATOR:
             yasm_xfree(curval.str_val);
             break;
         case STRING:
@@ -190,6 +191,7 @@ describe_token(int token)
         case SPECIAL_ID:        str = "..identifier"; break;
         case NONLOCAL_ID:       str = "..@identifier"; break;
         case LINE:              str = "%line"; break;
+        case DECORATOR:         str = "{decorator}"; break;
         default:
             strch[1] = token;
             str = strch;
@@ -739,6 +741,7 @@ parse_instr(yasm_parser_nasm *parser_nasm)
         case INSN:
         {
             yasm_insn *insn;
+            yasm_insn_operand *op = NULL;
             bc = INSN_val;
             insn = yasm_bc_get_insn(bc);
 
@@ -748,7 +751,25 @@ parse_instr(yasm_parser_nasm *parser_nasm)
 
             /* parse operands */
             for (;;) {
-                yasm_insn_operand *op = parse_operand(parser_nasm);
+                /* A rounding control such as {rn-sae} is written as a
+                 * separate operand, but applies to the preceding one.
+                 */
+                if (curtok == DECORATOR && op) {
+                    yasm_operand_add_decorator(op, p_object->arch,
+                                               DECORATOR_val);
+                    yasm_xfree(DECORATOR_val);
+                    get_next_token();
+                    if (is_eol())
+                        break;
+                    if (!expect(',')) {
+                        yasm_bc_destroy(bc);
+                        return NULL;
+                    }
+                    get_next_token();
+                    continue;
+                }
+
+                op = parse_operand(parser_nasm);
                 if (!op) {
                     if (insn->num_operands == 0)
                         yasm_error_set(YASM_ERROR_SYNTAX,
@@ -763,6 +784,14 @@ parse_instr(yasm_parser_nasm *parser_nasm)
                 }
                 yasm_insn_ops_append(insn, op);
 
+                /* Trailing decorators ({k1}, {z}, {1to16}) */
+                while (curtok == DECORATOR) {
+                    yasm_operand_add_decorator(op, p_object->arch,
+                                               DECORATOR_val);
+                    yasm_xfree(DECORATOR_val);
+                    get_next_token();
+                }
+
                 if (is_eol())
                     break;
                 if (!expect(',')) {
@@ -1564,12 +1593,18 @@ nasm_parser_directive(yasm_parser_nasm *parser_nasm, const char *name,
                       yasm_valparamhead *objext_valparams)
 {
     unsigned long line = cur_line;
+    unsigned int mode_bits = yasm_arch_get_address_size(p_object->arch);
     yasm_valparam *vp;
 
     if (!yasm_object_directive(p_object, name, "nasm", valparams,
-                               objext_valparams, line))
-        ;
-    else if (yasm__strcasecmp(name, "absolute") == 0) {
+                               objext_valparams, line)) {
+        /* CPU and BITS (also set by some section attributes) change which
+         * identifiers are instructions or registers.
+         */
+        if (yasm__strcasecmp(name, "cpu") == 0 ||
+            yasm_arch_get_address_size(p_object->arch) != mode_bits)
+            memset(parser_nasm->plain_ids, 0, sizeof(parser_nasm->plain_ids));
+    } else if (yasm__strcasecmp(name, "absolute") == 0) {
         if (!valparams) {
             yasm_error_set(YASM_ERROR_SYNTAX,
                            N_("directive `%s' requires an argument"),
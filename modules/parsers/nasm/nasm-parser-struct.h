@@ -40,6 +40,9 @@ typedef union {
     } str;
 } nasm_yystype;
 
+#define PLAIN_ID_CACHE_SIZE 256   /* must be a power of 2 */
+#define PLAIN_ID_MAXLEN     16
+
 typedef struct yasm_parser_nasm {
     int tasm;
     int masm;
@@ -57,6 +60,15 @@ typedef struct yasm_parser_nasm {
 
     /*@null@*/ yasm_bytecode *prev_bc;
 
+    /* Direct-mapped cache of identifiers (case-sensitive, as written) that
+     * are neither instructions, prefixes, nor registers in the current CPU
+     * and BITS mode; it is flushed when either changes.  Only
+     * identifiers of up to PLAIN_ID_MAXLEN characters are cached; longer
+     * ones (which may still be instructions, e.g. vgf2p8affineinvqb) are
+     * always looked up in the arch tables.
+     */
+    char plain_ids[PLAIN_ID_CACHE_SIZE][PLAIN_ID_MAXLEN+1];
+
     int save_input;
 
     yasm_scanner s;
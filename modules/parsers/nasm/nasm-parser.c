@@ -51,6 +51,8 @@ nasm_do_parse(yasm_object *object, yasm_preproc *pp, int save_input,
 
     parser_nasm.prev_bc = yasm_section_bcs_first(object->cur_section);
 
+    memset(parser_nasm.plain_ids, 0, sizeof(parser_nasm.plain_ids));
+
     parser_nasm.save_input = save_input;
 
     parser_nasm.peek_token = NONE;
@@ -63,6 +65,11 @@ nasm_do_parse(yasm_object *object, yasm_preproc *pp, int save_input,
 
     parser_nasm.state = INITIAL;
 
+    /* Lines are parsed one at a time, so the preprocessor can set the line
+     * map directly rather than sending us %line directives.
+     */
+    yasm_preproc_set_direct_linemap(pp, 1);
+
     nasm_parser_parse(&parser_nasm);
 
     /*yasm_scanner_delete(&parser_nasm.s);*/
@@ -72,6 +72,7 @@ enum tokentype {
     SPECIAL_ID,
     NONLOCAL_ID,
     LINE,
+    DECORATOR,
     NONE                /* special token for lookahead */
 };
 
@@ -109,6 +110,7 @@ enum nasm_parser_state {
 #define SEGREG_val              (curval.arch_data)
 #define TARGETMOD_val           (curval.arch_data)
 #define ID_val                  (curval.str_val)
+#define DECORATOR_val           (curval.str_val)
 
 #define cur_line        (yasm_linemap_get_current(parser_nasm->linemap))
 
@@ -0,0 +1,10 @@
+; Identifiers rejected only because of the current BITS or CPU mode must be
+; looked up again after the mode changes, even with warnings disabled.
+bits 32
+r8d:
+bits 64
+mov eax, r8d
+cpu 386
+cpuid:
+cpu 686
+cpuid
@@ -0,0 +1,3 @@
+#! /bin/sh
+${srcdir}/out_test.sh nasm_test modules/parsers/nasm/tests/nowarn "nasm-compat parser" "-w -f bin" ""
+exit $?
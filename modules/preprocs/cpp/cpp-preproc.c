@@ -383,6 +383,18 @@ cpp_preproc_add_standard(yasm_preproc *preproc, const char **macros)
     /* TODO */
 }
 
+static void
+cpp_preproc_print_stats(yasm_preproc *preproc, FILE *f)
+{
+    /* no statistics */
+}
+
+static void
+cpp_preproc_set_direct_linemap(yasm_preproc *preproc, int direct)
+{
+    /* line directives come from the external preprocessor */
+}
+
 /*******************************************************************************
     Preprocessor module object.
 *******************************************************************************/
@@ -398,5 +410,7 @@ yasm_preproc_module yasm_cpp_LTX_preproc = {
     cpp_preproc_predefine_macro,
     cpp_preproc_undefine_macro,
     cpp_preproc_define_builtin,
-    cpp_preproc_add_standard
+    cpp_preproc_add_standard,
+    cpp_preproc_print_stats,
+    cpp_preproc_set_direct_linemap
 };
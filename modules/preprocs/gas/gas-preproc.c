@@ -1394,6 +1394,18 @@ gas_preproc_add_standard(yasm_preproc *preproc, const char **macros)
     /* TODO */
 }
 
+static void
+gas_preproc_print_stats(yasm_preproc *preproc, FILE *f)
+{
+    /* no statistics */
+}
+
+static void
+gas_preproc_set_direct_linemap(yasm_preproc *preproc, int direct)
+{
+    /* the line map is always set directly */
+}
+
 
 /* Define preproc structure -- see preproc.h for details */
 yasm_preproc_module yasm_gas_LTX_preproc = {
@@ -1407,5 +1419,7 @@ yasm_preproc_module yasm_gas_LTX_preproc = {
     gas_preproc_predefine_macro,
     gas_preproc_undefine_macro,
     gas_preproc_define_builtin,
-    gas_preproc_add_standard
+    gas_preproc_add_standard,
+    gas_preproc_print_stats,
+    gas_preproc_set_direct_linemap
 };
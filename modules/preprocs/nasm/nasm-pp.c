@@ -54,6 +54,7 @@ typedef struct Token Token;
 typedef struct Blocks Blocks;
 typedef struct Line Line;
 typedef struct Include Include;
+typedef struct IncGuard IncGuard;
 typedef struct Cond Cond;
 
 /*
@@ -103,6 +104,7 @@ struct MMacro
 
     MMacro *next_active;
     MMacro *rep_nest;           /* used for nesting %rep */
+    Line *rep_cursor;           /* next %rep body line to replay */
     Token **params;             /* actual parameters */
     Token *iline;               /* invocation line */
     long nparam, rotate, *paramlen;
@@ -196,6 +198,34 @@ struct Include
     char *fname;
     int lineno, lineinc;
     MMacro *mstk;               /* stack of active macros/reps */
+    IncGuard *guard;            /* multiple-include record, if any */
+    int guard_state;            /* GUARD_* state of this file */
+};
+
+/*
+ * Files which turn out to be entirely wrapped in a single `%ifndef
+ * NAME' ... `%endif' block are remembered here, keyed on the
+ * including file and the name given to %include (which together
+ * determine the file that gets opened). While NAME is defined, a
+ * repeated %include of such a file can't produce anything, so we
+ * don't even open it.
+ */
+struct IncGuard
+{
+    IncGuard *next;
+    char *from;                 /* file containing the %include */
+    char *name;                 /* name given to %include */
+    char *fname;                /* file actually opened */
+    char *guard;                /* guard macro, NULL if not (yet) known */
+};
+enum
+{
+    /*
+     * GUARD_START: nothing but blank lines seen yet. GUARD_OPEN:
+     * inside the `%ifndef NAME' block. GUARD_CLOSED: just past its
+     * `%endif'. GUARD_NONE: the file isn't wrapped in a guard.
+     */
+    GUARD_START, GUARD_OPEN, GUARD_CLOSED, GUARD_NONE
 };
 
 /*
@@ -378,6 +408,13 @@ static MMacro *mmacros[NHASH];
  */
 static SMacro *smacros[NHASH];
 
+/*
+ * Include files known (or being checked) to have include guards, and
+ * the number of %includes skipped because of them.
+ */
+static IncGuard *incguards[NHASH];
+static unsigned long guard_skips;
+
 /*
  * The multi-line macro we are currently defining, or the %rep
  * block we are currently reading, if any.
@@ -1264,6 +1301,36 @@ read_line(void)
     return buffer;
 }
 
+/*
+ * In a non-emitting branch of a condition construct, the only lines
+ * from the input file that matter are the condition directives
+ * themselves (the %if, %elif, %else and %endif families, all of which
+ * start with `%i' or `%e'). Return TRUE if the raw line can't be one
+ * of those, so it can be dropped without being tokenised.
+ */
+static int
+skip_false_line(const char *line)
+{
+    if (!istk->conds || emitting(istk->conds->state) || defining ||
+            tasm_compatible_mode)
+        return FALSE;
+
+    while (isspace((unsigned char)*line))
+        line++;
+    if (*line != '%')
+        return TRUE;
+    switch (line[1])
+    {
+        case 'e':
+        case 'E':
+        case 'i':
+        case 'I':
+            return FALSE;
+        default:
+            return TRUE;
+    }
+}
+
 /*
  * Tokenise a line of text. This is a very simple process since we
  * don't need to parse the value out of e.g. numeric tokens: we
@@ -1869,6 +1936,97 @@ inc_fopen(char *file, char **newname)
     return fp;
 }
 
+/*
+ * Find the include guard record for a `%include name' issued from the
+ * current file, creating an empty one if there isn't one yet.
+ */
+static IncGuard *
+get_incguard(char *name)
+{
+    const char *from = nasm_src_get_fname();
+    IncGuard *g;
+    int h;
+
+    if (!from)
+        from = "";
+    h = hash(name);
+    for (g = incguards[h]; g; g = g->next)
+        if (!strcmp(g->name, name) && !strcmp(g->from, from))
+            return g;
+
+    g = nasm_malloc(sizeof(IncGuard));
+    g->next = incguards[h];
+    g->from = nasm_strdup(from);
+    g->name = nasm_strdup(name);
+    g->fname = NULL;
+    g->guard = NULL;
+    incguards[h] = g;
+    return g;
+}
+
+/*
+ * Track whether the file on top of the include stack consists of
+ * nothing but a single `%ifndef NAME' ... `%endif' block. Called
+ * with each line read from the file, before directive processing.
+ */
+static void
+check_incguard(Token *tline)
+{
+    Include *inc = istk;
+    Token *t = tline;
+
+    if (!inc->guard || inc->guard_state == GUARD_NONE)
+        return;
+    skip_white_(t);
+    if (!t)
+        return;                 /* blank or comment-only line */
+
+    switch (inc->guard_state)
+    {
+        case GUARD_START:
+            inc->guard_state = GUARD_NONE;
+            if (defining || inc->conds || !tok_type_(t, TOK_PREPROC_ID) ||
+                    nasm_stricmp(t->text, "%ifndef"))
+                return;
+            t = t->next;
+            skip_white_(t);
+            if (!tok_type_(t, TOK_ID))
+                return;
+            tline = t;
+            t = t->next;
+            skip_white_(t);
+            if (t)
+                return;
+            nasm_free(inc->guard->guard);
+            inc->guard->guard = nasm_strdup(tline->text);
+            inc->guard_state = GUARD_OPEN;
+            return;
+        case GUARD_OPEN:
+            /* only directives at the level of the guard itself matter */
+            if (defining || !tok_type_(t, TOK_PREPROC_ID))
+                return;
+            if (!inc->conds)
+                inc->guard_state = GUARD_NONE;
+            else if (inc->conds->next)
+                return;
+            else if (!nasm_stricmp(t->text, "%endif"))
+                inc->guard_state = GUARD_CLOSED;
+            else if (!nasm_strnicmp(t->text, "%el", 3))
+                inc->guard_state = GUARD_NONE;
+            return;
+        default:
+            /* anything after the closing %endif */
+            inc->guard_state = GUARD_NONE;
+            return;
+    }
+}
+
+unsigned long
+pp_get_guard_skips(void)
+{
+    return guard_skips;
+}
+
 /*
  * Determine if we should warn on defining a single-line macro of
  * name `name', with `nparam' parameters. If nparam is 0 or -1, will
@@ -2337,6 +2495,7 @@ do_directive(Token * tline)
     int offset;
     char *p, *mname, *newname;
     Include *inc;
+    IncGuard *guard;
     Context *ctx;
     Cond *cond;
     SMacro *smac, **smhead;
@@ -2731,16 +2890,33 @@ do_directive(Token * tline)
             else
                 p = tline->text;        /* internal_string is easier */
             expand_macros_in_string(&p);
+            guard = get_incguard(p);
+            if (guard->guard && smacro_defined(NULL, guard->guard, 0, NULL, 1))
+            {
+                /*
+                 * Everything in the file is inside a false %ifndef,
+                 * so skip it entirely.
+                 */
+                nasm_preproc_add_dep(guard->fname);
+                guard_skips++;
+                nasm_free(p);
+                free_tlist(origline);
+                return DIRECTIVE_FOUND;
+            }
             inc = nasm_malloc(sizeof(Include));
             inc->next = istk;
             inc->conds = NULL;
             inc->fp = inc_fopen(p, &newname);
             nasm_free(p);
+            if (!guard->fname)
+                guard->fname = nasm_strdup(newname);
             inc->fname = nasm_src_set_fname(newname);
             inc->lineno = nasm_src_set_linnum(0);
             inc->lineinc = 1;
             inc->expansion = NULL;
             inc->mstk = NULL;
+            inc->guard = guard;
+            inc->guard_state = GUARD_START;
             istk = inc;
             list->uplevel(LIST_INCLUDE);
             free_tlist(origline);
@@ -3003,6 +3179,7 @@ do_directive(Token * tline)
             defining->nolist = FALSE;
             defining->in_progress = FALSE;
             defining->rep_nest = NULL;
+            defining->rep_cursor = NULL;
             tline = expand_smacro(tline->next);
             skip_white_(tline);
             if (!tok_type_(tline, TOK_NUMBER))
@@ -3220,6 +3397,7 @@ do_directive(Token * tline)
             defining->expansion = NULL;
             defining->next_active = istk->mstk;
             defining->rep_nest = tmp_defining;
+            defining->rep_cursor = NULL;
             return DIRECTIVE_FOUND;
 
         case PP_ENDREP:
@@ -3239,7 +3417,21 @@ do_directive(Token * tline)
              * with another macro-end marker to ensure the process
              * continues) until the whole expansion is forcibly removed
              * from istk->expansion by a %exitrep.
+             *
+             * The body was collected in reverse order; turn it round
+             * so each repetition can be replayed from the front.
              */
+            {
+                Line *prev = NULL, *next;
+
+                for (l = defining->expansion; l; l = next)
+                {
+                    next = l->next;
+                    l->next = prev;
+                    prev = l;
+                }
+                defining->expansion = prev;
+            }
             l = nasm_malloc(sizeof(Line));
             l->next = istk->expansion;
             l->finishes = defining;
@@ -4081,6 +4273,15 @@ expand_mmac_params(Token * tline)
     return thead;
 }
 
+/*
+ * Markers for the `mac' field of tokens already on expand_smacro's
+ * output list. Tokens marked smac_recheck (changed by concatenation,
+ * or a macro call left unexpanded) must be looked at again when the
+ * line is re-scanned; those marked smac_done are known not to name a
+ * macro and are passed straight through.
+ */
+static SMacro smac_recheck, smac_done;
+
 /*
  * Expand all single-line macro calls made in the given line.
  * Return the expanded version of the line. The original is deemed
@@ -4095,7 +4296,7 @@ expand_smacro(Token * tline)
     SMacro *head = NULL, *m;
     Token **params;
     int *paramsize;
-    int nparam, sparam, brackets, rescan;
+    int nparam, sparam, brackets, rescan, painted = FALSE, marked;
     Token *org_tline = tline;
     Context *ctx;
     char *mname;
@@ -4119,9 +4320,20 @@ expand_smacro(Token * tline)
   again:
     tail = &thead;
     thead = NULL;
+    marked = FALSE;
 
     while (tline)
     {                           /* main token loop */
+        if (tline->mac == &smac_done)
+        {
+            /* Unchanged since the last scan and not a macro name */
+            t = *tail = tline;
+            tline = tline->next;
+            t->mac = NULL;
+            t->next = NULL;
+            tail = &t->next;
+            continue;
+        }
         if ((mname = tline->text))
         {
             /* if this token is a local macro, look in local context */
@@ -4321,6 +4533,7 @@ expand_smacro(Token * tline)
                     nasm_free(params);
                     nasm_free(paramsize);
                     tline = mstart;
+                    painted = TRUE;     /* might expand on a re-scan */
                 }
                 else
                 {
@@ -4391,7 +4604,13 @@ expand_smacro(Token * tline)
             t->mac = NULL;
             t->next = NULL;
             tail = &t->next;
+            if (painted)
+            {
+                t->mac = &smac_recheck;
+                marked = TRUE;
+            }
         }
+        painted = FALSE;
     }
 
     /*
@@ -4417,6 +4636,7 @@ expand_smacro(Token * tline)
             nasm_free(t->text);
             t->next = delete_Token(t->next);
             t->text = p;
+            t->mac = &smac_recheck;
             rescan = 1;
         }
         else if (t->next->type == TOK_WHITESPACE && t->next->next &&
@@ -4431,16 +4651,29 @@ expand_smacro(Token * tline)
                     break;
                 t->next = delete_Token(t->next);
             }                   /* endfor */
+            t->mac = &smac_recheck;
+            marked = TRUE;
         }
         else
             t = t->next;
     }
-    /* If we concatenaded something, re-scan the line for macros */
+    /*
+     * If we concatenated something, re-scan the line for macros. Only
+     * the tokens marked above can come out any differently this time;
+     * everything else is passed through without another lookup.
+     */
     if (rescan)
     {
+        for (t = thead; t; t = t->next)
+            t->mac = (t->mac == &smac_recheck) ? NULL : &smac_done;
         tline = thead;
         goto again;
     }
+    if (marked)
+    {
+        for (t = thead; t; t = t->next)
+            t->mac = NULL;
+    }
 
     if (org_tline)
     {
@@ -4850,12 +5083,15 @@ pp_reset(FILE *f, const char *file, int apass, efunc errfunc, evalfunc eval,
     istk->mstk = NULL;
     istk->fp = f;
     istk->fname = NULL;
+    istk->guard = NULL;
+    istk->guard_state = GUARD_NONE;
     nasm_free(nasm_src_set_fname(nasm_strdup(file)));
     nasm_src_set_linnum(0);
     istk->lineinc = 1;
     defining = NULL;
     nested_mac_count = 0;
     nested_rep_count = 0;
+    guard_skips = 0;
     for (h = 0; h < NHASH; h++)
     {
         mmacros[h] = NULL;
@@ -4900,11 +5136,65 @@ poke_predef(Line *predef_lines)
     }
 }
 
+/*
+ * Can a stored %rep body line be emitted exactly as it stands?  That is
+ * the case when no step of pp_getline() would change it: it contains no
+ * preprocessor tokens (directives, macro parameters, context-local
+ * labels, %+), no names of single- or multi-line macros, and none of the
+ * adjacent tokens that expand_mmac_params() joins together.  Such lines
+ * are detokenised straight from the stored tokens, which stay untouched.
+ */
+static int
+rep_line_is_plain(Token *tline)
+{
+    Token *t;
+    SMacro *sm;
+    MMacro *mm;
+
+    if (tasm_compatible_mode)
+        return FALSE;
+    for (t = tline; t; t = t->next)
+    {
+        switch (t->type)
+        {
+            case TOK_WHITESPACE:
+                if (t->next && t->next->type == TOK_WHITESPACE)
+                    return FALSE;
+                continue;
+            case TOK_ID:
+                if (t->next && (t->next->type == TOK_ID ||
+                                t->next->type == TOK_NUMBER))
+                    return FALSE;
+                for (sm = smacros[hash(t->text)]; sm; sm = sm->next)
+                    if (!mstrcmp(sm->name, t->text, sm->casesense))
+                        return FALSE;
+                for (mm = mmacros[hash(t->text)]; mm; mm = mm->next)
+                    if (!mstrcmp(mm->name, t->text, mm->casesense))
+                        return FALSE;
+                break;
+            case TOK_NUMBER:
+                if (t->next && t->next->type == TOK_NUMBER)
+                    return FALSE;
+                break;
+            case TOK_COMMENT:
+            case TOK_STRING:
+            case TOK_OTHER:
+                break;
+            default:
+                return FALSE;
+        }
+        if (!t->text)
+            return FALSE;
+    }
+    return TRUE;
+}
+
 static char *
 pp_getline(void)
 {
     char *line;
     Token *tline;
+    int rep_skip;
 
     while (1)
     {
@@ -4913,6 +5203,7 @@ pp_getline(void)
          * buffer or from the input file.
          */
         tline = NULL;
+        rep_skip = FALSE;
 
         if (first_line)
         {
@@ -4925,13 +5216,12 @@ pp_getline(void)
 
         if (!istk)
             return NULL;
-        while (istk->expansion && istk->expansion->finishes)
+        while (istk->expansion && istk->expansion->finishes &&
+               !istk->expansion->finishes->rep_cursor)
         {
             Line *l = istk->expansion;
             if (!l->finishes->name && l->finishes->in_progress > 1)
             {
-                Line *ll;
-
                 /*
                  * This is a macro-end marker for a macro with no
                  * name, which means it's not really a macro at all
@@ -4940,33 +5230,15 @@ pp_getline(void)
                  * repeat. (1 means the natural last repetition; 0
                  * means termination by %exitrep.) We have
                  * therefore expanded up to the %endrep, and must
-                 * push the whole block on to the expansion buffer
-                 * again. We don't bother to remove the macro-end
-                 * marker: we'd only have to generate another one
-                 * if we did.
+                 * replay the whole block again. Rather than
+                 * copying it all on to the expansion buffer, we
+                 * leave the macro-end marker where it is and point
+                 * its cursor at the start of the body; the lines
+                 * are then copied out one at a time below, as
+                 * they're needed.
                  */
                 l->finishes->in_progress--;
-                for (l = l->finishes->expansion; l; l = l->next)
-                {
-                    Token *t, *tt, **tail;
-
-                    ll = nasm_malloc(sizeof(Line));
-                    ll->next = istk->expansion;
-                    ll->finishes = NULL;
-                    ll->first = NULL;
-                    tail = &ll->first;
-
-                    for (t = l->first; t; t = t->next)
-                    {
-                        if (t->text || t->type == TOK_WHITESPACE)
-                        {
-                            tt = *tail = new_Token(NULL, t->type, t->text, 0);
-                            tail = &tt->next;
-                        }
-                    }
-
-                    istk->expansion = ll;
-                }
+                l->finishes->rep_cursor = l->finishes->expansion;
             }
             else
             {
@@ -5022,20 +5294,61 @@ pp_getline(void)
                 Line *l = istk->expansion;
                 if (istk->mstk)
                     istk->mstk->lineno++;
-                tline = l->first;
-                istk->expansion = l->next;
-                nasm_free(l);
+                if (l->finishes)
+                {
+                    /* next line of a %rep body being replayed */
+                    Line *body = l->finishes->rep_cursor;
+                    Token *t, *tt, **tail = &tline;
+
+                    l->finishes->rep_cursor = body->next;
+                    if (!defining && rep_line_is_plain(body->first))
+                    {
+                        /*
+                         * Nothing can change the line, so it needs no
+                         * copy: emit it unless we're skipping lines.
+                         */
+                        p = detoken(body->first, FALSE);
+                        list->line(LIST_MACRO, p);
+                        if (!(istk->conds && !emitting(istk->conds->state))
+                            && !(istk->mstk && !istk->mstk->in_progress))
+                            return p;
+                        nasm_free(p);
+                        rep_skip = TRUE;
+                        break;
+                    }
+                    for (t = body->first; t; t = t->next)
+                    {
+                        if (t->text || t->type == TOK_WHITESPACE)
+                        {
+                            tt = *tail = new_Token(NULL, t->type, t->text, 0);
+                            tail = &tt->next;
+                        }
+                    }
+                    *tail = NULL;
+                }
+                else
+                {
+                    tline = l->first;
+                    istk->expansion = l->next;
+                    nasm_free(l);
+                }
                 p = detoken(tline, FALSE);
                 list->line(LIST_MACRO, p);
                 nasm_free(p);
                 break;
             }
             line = read_line();
+            if (line && skip_false_line(line))
+            {
+                nasm_free(line);
+                continue;
+            }
             if (line)
             {                   /* from the current input file */
                 line = prepreproc(line);
                 tline = tokenise(line);
                 nasm_free(line);
+                check_incguard(tline);
                 break;
             }
             /*
@@ -5047,6 +5360,12 @@ pp_getline(void)
                     fclose(i->fp);
                 if (i->conds)
                     error(ERR_FATAL, "expected `%%endif' before end of file");
+                if (i->guard && i->guard_state != GUARD_CLOSED)
+                {
+                    /* not (or no longer) a guarded file */
+                    nasm_free(i->guard->guard);
+                    i->guard->guard = NULL;
+                }
                 /* only set line and file name if there's a next node */
                 if (i->next) 
                 {
@@ -5059,10 +5378,14 @@ pp_getline(void)
                 nasm_free(i);
                 if (!istk)
                     return NULL;
-                if (istk->expansion && istk->expansion->finishes)
+                /* keep reading a %rep body that's still being replayed */
+                if (istk->expansion && istk->expansion->finishes &&
+                    !istk->expansion->finishes->rep_cursor)
                     break;
             }
         }
+        if (rep_skip)
+            continue;
 
         /*
          * We must expand MMacro parameters and MMacro-local labels
@@ -5192,6 +5515,19 @@ pp_cleanup(int pass_)
     }
     while (cstk)
         ctx_pop();
+    for (h = 0; h < NHASH; h++)
+    {
+        while (incguards[h])
+        {
+            IncGuard *g = incguards[h];
+            incguards[h] = incguards[h]->next;
+            nasm_free(g->from);
+            nasm_free(g->name);
+            nasm_free(g->fname);
+            nasm_free(g->guard);
+            nasm_free(g);
+        }
+    }
     if (pass_ == 0)
         {
                 free_llist(builtindef);
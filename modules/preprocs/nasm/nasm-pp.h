@@ -14,6 +14,7 @@ void pp_pre_define (char *);
 void pp_pre_undefine (char *);
 void pp_builtin_define (char *);
 void pp_extra_stdmac (const char **);
+unsigned long pp_get_guard_skips (void);
 
 extern Preproc nasmpp;
 
@@ -39,8 +39,10 @@ typedef struct yasm_preproc_nasm {
     FILE *in;
     char *line;
     char *file_name;
+    /*@dependent@*/ const char *lm_file_name;   /* file_name in cur_lm */
     long prior_linnum;
     int lineinc;
+    int direct_linemap;
 } yasm_preproc_nasm;
 yasm_symtab *nasm_symtab;
 static yasm_linemap *cur_lm;
@@ -155,8 +157,10 @@ nasm_preproc_create(const char *in_filename, yasm_symtab *symtab,
     done_dep_preproc = 0;
     preproc_nasm->line = NULL;
     preproc_nasm->file_name = NULL;
+    preproc_nasm->lm_file_name = NULL;
     preproc_nasm->prior_linnum = 0;
     preproc_nasm->lineinc = 0;
+    preproc_nasm->direct_linemap = 0;
     nasmpp.reset(f, in_filename, 2, nasm_efunc, nasm_evaluate, &nil_list);
 
     pp_extra_stdmac(nasm_version_mac);
@@ -204,13 +208,22 @@ nasm_preproc_get_line(yasm_preproc *preproc)
 
     linnum = preproc_nasm->prior_linnum += preproc_nasm->lineinc;
     altline = nasm_src_get(&linnum, &preproc_nasm->file_name);
+    if (altline == -2)
+        preproc_nasm->lm_file_name =
+            yasm_linemap_intern_filename(cur_lm, preproc_nasm->file_name);
     if (altline != 0) {
         preproc_nasm->lineinc =
             (altline != -1 || preproc_nasm->lineinc != 1);
-        preproc_nasm->line = line;
-        line = yasm_xmalloc(40+strlen(preproc_nasm->file_name));
-        sprintf(line, "%%line %ld+%d %s", linnum,
-                preproc_nasm->lineinc, preproc_nasm->file_name);
+        if (preproc_nasm->direct_linemap)
+            yasm_linemap_set_interned(cur_lm, preproc_nasm->lm_file_name, 0,
+                                      (unsigned long)linnum,
+                                      (unsigned long)preproc_nasm->lineinc);
+        else {
+            preproc_nasm->line = line;
+            line = yasm_xmalloc(40+strlen(preproc_nasm->file_name));
+            sprintf(line, "%%line %ld+%d %s", linnum,
+                    preproc_nasm->lineinc, preproc_nasm->file_name);
+        }
         preproc_nasm->prior_linnum = linnum;
     }
 
@@ -307,6 +320,19 @@ nasm_preproc_add_standard(yasm_preproc *preproc, const char **macros)
     pp_extra_stdmac(macros);
 }
 
+static void
+nasm_preproc_print_stats(yasm_preproc *preproc, FILE *f)
+{
+    fprintf(f, "  %-20s %10lu\n", "include guard skips",
+            pp_get_guard_skips());
+}
+
+static void
+nasm_preproc_set_direct_linemap(yasm_preproc *preproc, int direct)
+{
+    ((yasm_preproc_nasm *)preproc)->direct_linemap = direct;
+}
+
 /* Define preproc structure -- see preproc.h for details */
 yasm_preproc_module yasm_nasm_LTX_preproc = {
     "Real NASM Preprocessor",
@@ -319,7 +345,9 @@ yasm_preproc_module yasm_nasm_LTX_preproc = {
     nasm_preproc_predefine_macro,
     nasm_preproc_undefine_macro,
     nasm_preproc_define_builtin,
-    nasm_preproc_add_standard
+    nasm_preproc_add_standard,
+    nasm_preproc_print_stats,
+    nasm_preproc_set_direct_linemap
 };
 
 static yasm_preproc *
@@ -341,5 +369,7 @@ yasm_preproc_module yasm_tasm_LTX_preproc = {
     nasm_preproc_predefine_macro,
     nasm_preproc_undefine_macro,
     nasm_preproc_define_builtin,
-    nasm_preproc_add_standard
+    nasm_preproc_add_standard,
+    nasm_preproc_print_stats,
+    nasm_preproc_set_direct_linemap
 };
@@ -0,0 +1,32 @@
+; Lines inside false conditional blocks must be skipped, but nested
+; conditionals inside them still have to be tracked.
+%define YES
+%if 0
+ db 1
+ %error should not be seen
+ db 'unterminated
+	%if 1
+	 db 2
+	%else
+	 db 3
+	%endif
+%elif 0
+ db 4
+%else
+ db 5
+ %ifdef YES
+  db 6
+ %else
+  %ifndef YES
+   db 7 \
+   %endif
+  %endif
+  db 8
+ %endif
+%endif
+%IFDEF NOPE
+ db 9
+%ELSE
+ db 10
+%ENDIF
+db __LINE__
@@ -0,0 +1,56 @@
+; %rep bodies are replayed line by line; check nesting, %exitrep and
+; empty bodies.
+%assign i 0
+%rep 3
+  %assign j 0
+  %rep 4
+    db i*16+j
+    %assign j j+1
+    %if j == 3
+      %exitrep
+    %endif
+    db 0xEE
+  %endrep
+  %assign i i+1
+%endrep
+%macro M 1
+  %rep %1
+    dw %1
+  %endrep
+%endmacro
+%rep 2
+M 3
+%endrep
+%rep 0
+db 0xFF
+%endrep
+%rep 5
+%endrep
+%assign k 0
+%rep 10
+%assign k k+1
+%if k > 4
+%exitrep
+%endif
+db k, __LINE__
+%endrep
+; Lines are emitted from the stored body without copying only while
+; nothing on them names a macro; names defined by earlier repetitions
+; must still be expanded.
+val equ 1
+%assign n 0
+%rep 3
+db val
+%if n == 0
+%define val 7
+%else
+db 0xDD, n
+%endif
+ww
+%if n == 0
+%imacro WW 0
+dw 0x1234
+%endmacro
+%endif
+%assign n n+1
+%endrep
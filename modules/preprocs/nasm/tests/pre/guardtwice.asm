@@ -0,0 +1,12 @@
+; A second %include of a fully guarded file is skipped while the guard
+; macro is defined; the output must be the same as if it were re-read.
+%include "guard.inc"
+db guard_value
+%include "guard.inc"
+db guard_value
+; undefining the guard makes the file's contents visible again
+%undef GUARD_INC
+%include "guard.inc"
+; code after the %endif means the file isn't guarded
+%include "partguard.inc"
+%include "partguard.inc"
@@ -0,0 +1,3 @@
+#! /bin/sh
+${srcdir}/text_test.sh nasmpp_pre_test modules/preprocs/nasm/tests/pre "nasm preproc -e" "-e -I${srcdir}/modules/preprocs/nasm/tests/pre/" ".pre" stdin
+exit $?
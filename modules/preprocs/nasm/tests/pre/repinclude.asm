@@ -0,0 +1,12 @@
+; %include inside a %rep body, with body lines after it
+%assign rep_count 0
+%rep 3
+%include "repinc.inc"
+%assign rep_count rep_count+1
+dw rep_count
+%endrep
+; and as the last line of the body
+%rep 2
+dd rep_count
+%include "repinc.inc"
+%endrep
@@ -0,0 +1,3 @@
+#! /bin/sh
+${srcdir}/text_test.sh nasmpp_showsrc_stdin_test modules/preprocs/nasm/tests/showsrc-stdin "nasm preproc --show-source stdin" "-f bin --show-source -I${srcdir}/modules/preprocs/nasm/tests/showsrc/" "" stdin
+exit $?
@@ -0,0 +1,3 @@
+; Standard input can't be re-read, so only the included file gets excerpts.
+	mov eax, bl		; no excerpt for standard input
+%include "showsrc.inc"
@@ -0,0 +1,3 @@
+#! /bin/sh
+${srcdir}/text_test.sh nasmpp_showsrc_test modules/preprocs/nasm/tests/showsrc "nasm preproc --show-source" "-f bin --show-source -I${srcdir}/modules/preprocs/nasm/tests/showsrc/"
+exit $?
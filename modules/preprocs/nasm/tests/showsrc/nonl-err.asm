@@ -0,0 +1,3 @@
+; The last line has no newline.
+	mov al, 1
+	push al
\ No newline at end of file
@@ -0,0 +1,6 @@
+; Errors in the main file and in an included file are shown with the line.
+	mov ax, 1
+	mov eax, bl		; error in the main file
+%include "showsrc.inc"
+	db 256, 257		; two messages, one excerpt
+	mov ax, 2
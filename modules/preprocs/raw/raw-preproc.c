@@ -152,6 +152,18 @@ raw_preproc_add_standard(yasm_preproc *preproc, const char **macros)
     /* no standard macros */
 }
 
+static void
+raw_preproc_print_stats(yasm_preproc *preproc, FILE *f)
+{
+    /* no statistics */
+}
+
+static void
+raw_preproc_set_direct_linemap(yasm_preproc *preproc, int direct)
+{
+    /* no line directives are generated */
+}
+
 
 /* Define preproc structure -- see preproc.h for details */
 yasm_preproc_module yasm_raw_LTX_preproc = {
@@ -165,5 +177,7 @@ yasm_preproc_module yasm_raw_LTX_preproc = {
     raw_preproc_predefine_macro,
     raw_preproc_undefine_macro,
     raw_preproc_define_builtin,
-    raw_preproc_add_standard
+    raw_preproc_add_standard,
+    raw_preproc_print_stats,
+    raw_preproc_set_direct_linemap
 };
@@ -1004,6 +1004,18 @@ yapp_preproc_add_standard(yasm_preproc *preproc, const char **macros)
     /* TODO */
 }
 
+static void
+yapp_preproc_print_stats(yasm_preproc *preproc, FILE *f)
+{
+    /* no statistics */
+}
+
+static void
+yapp_preproc_set_direct_linemap(yasm_preproc *preproc, int direct)
+{
+    /* line directives are always inserted */
+}
+
 /* Define preproc structure -- see preproc.h for details */
 yasm_preproc_module yasm_yapp_LTX_preproc = {
     "YAPP preprocessing (NASM style)",
@@ -1016,5 +1028,7 @@ yasm_preproc_module yasm_yapp_LTX_preproc = {
     yapp_preproc_predefine_macro,
     yapp_preproc_undefine_macro,
     yapp_preproc_define_builtin,
-    yapp_preproc_add_standard
+    yapp_preproc_add_standard,
+    yapp_preproc_print_stats,
+    yapp_preproc_set_direct_linemap
 };
@@ -0,0 +1,131 @@
+#! /bin/sh
+# Like out_test.sh, but for tests whose result is text written to standard
+# output (for example preprocessed source or a report) rather than an
+# object file.
+#
+# $1 = test name, $2 = test directory, $3 = description, $4 = yasm options,
+# $5 = suffix of the expected standard output files (which may be omitted
+# for tests that print nothing), $6 = `stdin' to feed the source through
+# standard input instead of naming the file.
+#
+# Paths under ${srcdir} in the output and messages are rewritten to start
+# with `./', so expected files don't depend on where the tests are run.
+
+YASM_TEST_SUITE=1
+export YASM_TEST_SUITE
+
+case `echo "testing\c"; echo 1,2,3`,`echo -n testing; echo 1,2,3` in
+  *c*,-n*) ECHO_N= ECHO_C='
+' ECHO_T='	' ;;
+  *c*,*  ) ECHO_N=-n ECHO_C= ECHO_T= ;;
+  *)       ECHO_N= ECHO_C='\c' ECHO_T= ;;
+esac
+
+mkdir results >/dev/null 2>&1
+
+#
+# Verify that all test cases match
+#
+
+passedct=0
+failedct=0
+
+srcdir_re=`echo ${srcdir} | sed 's,\.,\\\\.,g'`
+
+echo $ECHO_N "Test $1: $ECHO_C"
+for asm in ${srcdir}/$2/*.asm
+do
+    a=`echo ${asm} | sed 's,^.*/,,;s,.asm$,,'`
+    o=${a}.tx
+    og=`echo ${asm} | sed "s,.asm$,$5,"`
+    e=${a}.ew
+    eg=`echo ${asm} | sed 's,.asm$,.errwarn,'`
+    if test \! -f ${og}; then
+        og=/dev/null
+    fi
+    if test \! -f ${eg}; then
+        eg=/dev/null
+    fi
+
+    # Preprocessed output goes to standard output; objects are kept apart.
+    case " $4 " in
+        *" -e "*) out= ;;
+        *) out="-o results/${a}.o" ;;
+    esac
+    if test "$6" = "stdin"; then
+        cmd="cat ${asm} | ./yasm $4 ${out} -"
+    else
+        cmd="./yasm $4 ${out} ${asm}"
+    fi
+
+    # Run within a subshell to prevent signal messages from displaying.
+    sh -c "${cmd} >results/${o}.raw 2>results/${e}.raw" >/dev/null 2>/dev/null
+    status=$?
+    sed "s,${srcdir_re}/,./,g" results/${o}.raw > results/${o}
+    sed "s,${srcdir_re}/,./,g" results/${e}.raw > results/${e}
+    if test $status -gt 128; then
+        # We should never get a coredump!
+        echo $ECHO_N "C$ECHO_C"
+        eval "failed$failedct='C: ${a} crashed!'"
+        failedct=`expr $failedct + 1`
+    elif test $status -gt 0; then
+        echo ${asm} | grep err >/dev/null
+        if test $? -gt 0; then
+            # YASM detected errors but shouldn't have!
+            echo $ECHO_N "E$ECHO_C"
+            eval "failed$failedct='E: ${a} returned an error code!'"
+            failedct=`expr $failedct + 1`
+        else
+            # We got errors, check to see if they match:
+            if diff -w ${eg} results/${e} >/dev/null; then
+                # Error/warnings match, it passes!
+                echo $ECHO_N ".$ECHO_C"
+                passedct=`expr $passedct + 1`
+            else
+                # Error/warnings don't match.
+                echo $ECHO_N "W$ECHO_C"
+                eval "failed$failedct='W: ${a} did not match errors and warnings!'"
+                failedct=`expr $failedct + 1`
+            fi
+        fi
+    else
+        echo ${asm} | grep -v err >/dev/null
+        if test $? -gt 0; then
+            # YASM didn't detect errors but should have!
+            echo $ECHO_N "E$ECHO_C"
+            eval "failed$failedct='E: ${a} did not return an error code!'"
+            failedct=`expr $failedct + 1`
+        else
+            if diff -w ${og} results/${o} >/dev/null; then
+                if diff -w ${eg} results/${e} >/dev/null; then
+                    # Both output and error/warnings match, it passes!
+                    echo $ECHO_N ".$ECHO_C"
+                    passedct=`expr $passedct + 1`
+                else
+                    # Error/warnings don't match.
+                    echo $ECHO_N "W$ECHO_C"
+                    eval "failed$failedct='W: ${a} did not match errors and warnings!'"
+                    failedct=`expr $failedct + 1`
+                fi
+            else
+                # Output doesn't match.
+                echo $ECHO_N "O$ECHO_C"
+                eval "failed$failedct='O: ${a} did not match output!'"
+                failedct=`expr $failedct + 1`
+            fi
+        fi
+    fi
+done
+
+ct=`expr $failedct + $passedct`
+per=`expr 100 \* $passedct / $ct`
+
+echo " +$passedct-$failedct/$ct $per%"
+i=0
+while test $i -lt $failedct; do
+    eval "failure=\$failed$i"
+    echo " ** $failure"
+    i=`expr $i + 1`
+done
+
+exit $failedct